@@ -0,0 +1,389 @@
+#include <standalone-propagator/propagator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Benchmarks for the propagator; build in release mode and run
+ * without arguments for all workloads, or with a workload name.
+ * Each workload reports the best of several repetitions.
+ */
+
+namespace {
+
+using namespace sprop;
+
+/**
+ * Two-colored van der Waerden formula: {1, ..., n} contains no arithmetic
+ * progression of length k1 in color 1 (true) and none of length k2 in color 2.
+ */
+ModelBuilder waerden(int k1, int k2, int n) {
+    ModelBuilder builder;
+    builder.reserve_variables(n);
+    std::vector<Lit> clause;
+    auto add_progressions = [&] (int k, Lit sign) {
+        for(int distance = 1; (k - 1) * distance < n; ++distance) {
+            for(int start = 0; start + (k - 1) * distance < n; ++start) {
+                clause.clear();
+                for(int i = 0; i < k; ++i) {
+                    clause.push_back(lit::positive_lit(Var(start + i * distance)) ^ sign);
+                }
+                builder.add_clause(clause);
+            }
+        }
+    };
+    add_progressions(k1, 1);
+    add_progressions(k2, 0);
+    return builder;
+}
+
+/**
+ * Add num_clauses random clauses with k literals on distinct variables.
+ */
+void add_random_clauses(ModelBuilder& builder, int k, int num_vars, int num_clauses, std::mt19937_64& rng) {
+    std::uniform_int_distribution<Var> var_dist(0, Var(num_vars - 1));
+    std::vector<Lit> clause;
+    for(int i = 0; i < num_clauses; ++i) {
+        clause.clear();
+        while(clause.size() < std::size_t(k)) {
+            Var v = var_dist(rng);
+            if(std::ranges::any_of(clause, [&] (Lit l) { return lit::var(l) == v; })) continue;
+            clause.push_back(lit::positive_lit(v) ^ Lit(rng() & 1));
+        }
+        builder.add_clause(clause);
+    }
+}
+
+ModelBuilder random_ksat(int k, int num_vars, int num_clauses, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    ModelBuilder builder;
+    builder.reserve_variables(num_vars);
+    add_random_clauses(builder, k, num_vars, num_clauses, rng);
+    return builder;
+}
+
+/**
+ * Random clauses with a binary part just above the 2-SAT threshold
+ * (1.05 clauses per variable), so that many literals fail because of
+ * binary clauses alone, and twice as many clauses of length 3 and 5.
+ */
+ModelBuilder random_binary_heavy(int num_vars, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    ModelBuilder builder;
+    builder.reserve_variables(num_vars);
+    add_random_clauses(builder, 2, num_vars, num_vars + num_vars / 20, rng);
+    add_random_clauses(builder, 3, num_vars, num_vars, rng);
+    add_random_clauses(builder, 5, num_vars, 2 * num_vars, rng);
+    return builder;
+}
+
+/**
+ * Independent random 3-SAT formulas with the variables of
+ * the blocks interleaved (variable i belongs to block i % num_blocks),
+ * so that the CDCL loop below makes decisions on all blocks
+ * in turn, and conflicts within a block jump back over
+ * the levels of the other blocks.
+ */
+ModelBuilder interleaved_3sat_blocks(int num_blocks, int block_vars, int block_clauses, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<Var> var_dist(0, Var(block_vars - 1));
+    ModelBuilder builder;
+    builder.reserve_variables(Var(num_blocks) * Var(block_vars));
+    std::vector<Lit> clause;
+    for(Var block = 0; block < Var(num_blocks); ++block) {
+        for(int i = 0; i < block_clauses; ++i) {
+            clause.clear();
+            while(clause.size() < 3) {
+                Var v = var_dist(rng) * Var(num_blocks) + block;
+                if(std::ranges::any_of(clause, [&] (Lit l) { return lit::var(l) == v; })) continue;
+                clause.push_back(lit::positive_lit(v) ^ Lit(rng() & 1));
+            }
+            builder.add_clause(clause);
+        }
+    }
+    return builder;
+}
+
+/**
+ * Disjoint at-least-one constraints over length variables each;
+ * every constraint occurs twice, once extended by a fresh variable
+ * and once by its negation, so that the CDCL loop below learns it
+ * (as it decides all variables negatively, in order).
+ */
+ModelBuilder at_least_one_pairs(int num_constraints, int length) {
+    ModelBuilder builder;
+    Var num_vars = Var(num_constraints) * Var(length + 1);
+    builder.reserve_variables(num_vars);
+    std::vector<Lit> clause;
+    for(Var k = 0; k < Var(num_constraints); ++k) {
+        clause.clear();
+        for(Var j = 0; j < Var(length); ++j) {
+            clause.push_back(lit::positive_lit(k * Var(length) + j));
+        }
+        Var fresh = Var(num_constraints) * Var(length) + k;
+        clause.push_back(lit::positive_lit(fresh));
+        builder.add_clause(clause);
+        clause.back() = lit::negative_lit(fresh);
+        builder.add_clause(clause);
+    }
+    return builder;
+}
+
+/**
+ * A very simple CDCL loop (always deciding the first open variable negatively).
+ */
+bool solve_cdcl(Propagator& propagator) {
+    if(propagator.is_conflicting()) return false;
+    Lit next = 0;
+    for(;;) {
+        while(next < 2 * propagator.num_vars() && !propagator.is_open(next)) next += 2;
+        if(next >= 2 * propagator.num_vars()) return true;
+        if(!propagator.push_level(lit::negate(next))) {
+            if(!propagator.resolve_conflicts()) return false;
+            next = 0;
+        }
+    }
+}
+
+/**
+ * Like solve_cdcl, but stopping after max_conflicts conflicts;
+ * returns the number of assigned literals summed over all conflicts,
+ * which depends on the order of the trail after each conflict.
+ */
+std::size_t bounded_cdcl(Propagator& propagator, std::size_t max_conflicts) {
+    std::size_t assigned = 0;
+    Lit next = 0;
+    for(std::size_t conflicts = 0; conflicts < max_conflicts && !propagator.is_conflicting();) {
+        while(next < 2 * propagator.num_vars() && !propagator.is_open(next)) next += 2;
+        if(next >= 2 * propagator.num_vars()) break;
+        if(!propagator.push_level(lit::negate(next))) {
+            ++conflicts;
+            if(!propagator.resolve_conflicts()) break;
+            assigned += propagator.get_trail().size();
+            next = 0;
+        }
+    }
+    return assigned;
+}
+
+/**
+ * Repeatedly make random decisions until a conflict or full assignment
+ * occurs, then backtrack to level 0; measures raw propagation speed.
+ */
+std::size_t random_dives(Propagator& propagator, std::size_t num_dives, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<Lit> lit_dist(0, 2 * propagator.num_vars() - 1);
+    std::size_t assigned = 0;
+    for(std::size_t dive = 0; dive < num_dives; ++dive) {
+        for(;;) {
+            if(propagator.get_trail().size() == propagator.num_vars()) break;
+            Lit l = lit_dist(rng);
+            if(!propagator.is_open(l)) continue;
+            if(!propagator.push_level(l)) break;
+        }
+        assigned += propagator.get_trail().size();
+        propagator.reset_to_zero();
+    }
+    return assigned;
+}
+
+/**
+ * Like random_dives, but deciding only negative literals,
+ * in a random variable order; falsifies the literals of
+ * positive clauses one at a time.
+ */
+std::size_t negative_dives(Propagator& propagator, std::size_t num_dives, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<Var> order(propagator.num_vars());
+    std::iota(order.begin(), order.end(), Var(0));
+    std::size_t assigned = 0;
+    for(std::size_t dive = 0; dive < num_dives; ++dive) {
+        std::ranges::shuffle(order, rng);
+        for(Var v : order) {
+            Lit l = lit::negative_lit(v);
+            if(!propagator.is_open(l)) continue;
+            if(!propagator.push_level(l)) break;
+        }
+        assigned += propagator.get_trail().size();
+        propagator.reset_to_zero();
+    }
+    return assigned;
+}
+
+/**
+ * Push and pop every open literal at level 0 once (failed literal probing
+ * without learning); returns the number of failed literals.
+ */
+std::size_t probe_all(Propagator& propagator) {
+    std::size_t failed = 0;
+    for(Lit l : propagator.all_literals()) {
+        if(!propagator.is_open(l)) continue;
+        failed += !propagator.push_level(l);
+        propagator.pop_level();
+    }
+    return failed;
+}
+
+/**
+ * Answer queries with num_assumptions random assumptions each, either
+ * with push_assumptions or by pushing the levels one by one; returns
+ * the total number of assumptions that held.
+ */
+std::size_t assumption_queries(Propagator& propagator, std::size_t num_queries, 
+                               std::size_t num_assumptions, bool batch, std::uint64_t seed) 
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<Lit> lit_dist(0, 2 * propagator.num_vars() - 1);
+    std::vector<Lit> assumptions(num_assumptions);
+    std::size_t held = 0;
+    for(std::size_t query = 0; query < num_queries; ++query) {
+        std::ranges::generate(assumptions, [&] { return lit_dist(rng); });
+        if(batch) {
+            held += propagator.push_assumptions(assumptions);
+        } else {
+            for(Lit l : assumptions) {
+                if(propagator.is_true(l)) {
+                    ++held;
+                    continue;
+                }
+                if(propagator.is_false(l) || !propagator.push_level(l)) break;
+                ++held;
+            }
+        }
+        propagator.reset_to_zero();
+    }
+    return held;
+}
+
+struct Workload {
+    const char* name;
+    std::function<std::size_t()> run;
+};
+
+double time_best_of(const Workload& workload, int repetitions, std::size_t& result) {
+    double best = 1e100;
+    for(int r = 0; r < repetitions; ++r) {
+        auto begin = std::chrono::steady_clock::now();
+        result = workload.run();
+        auto end = std::chrono::steady_clock::now();
+        best = (std::min)(best, std::chrono::duration<double>(end - begin).count());
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const ModelBuilder waerden_sat = waerden(4, 5, 54);
+    const ModelBuilder waerden_unsat = waerden(4, 5, 55);
+    std::vector<ModelBuilder> random_3sat;
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        random_3sat.push_back(random_ksat(3, 120, 511, seed));
+    }
+    const ModelBuilder large_3sat = random_ksat(3, 100000, 400000, 1);
+    const ModelBuilder long_clauses = random_ksat(60, 2000, 20000, 2);
+    const ModelBuilder very_long_clauses = random_ksat(200, 2000, 10000, 5);
+    const ModelBuilder learnt_at_least_one = at_least_one_pairs(100, 1000);
+    const ModelBuilder binary_heavy = random_binary_heavy(30000, 13);
+    const ModelBuilder assumption_formula = random_ksat(3, 50000, 100000, 14);
+    const ModelBuilder deep_3sat = interleaved_3sat_blocks(200, 100, 410, 16);
+    // ~380 MB of propagator state, i.e., larger than the last-level cache;
+    // only built if one of its workloads runs, and shared by them
+    // (the dives leave it at level 0), so that only propagation is timed;
+    // each run uses new dive seeds, as repeating the same dives
+    // would find all blockers already true
+    std::optional<Propagator> huge;
+    std::uint64_t huge_seed = 7;
+    auto huge_5sat = [&] (std::uint32_t prefetch_lookahead) -> Propagator& {
+        if(!huge) huge.emplace(random_ksat(5, 300000, 6000000, 8));
+        huge->set_prefetch_lookahead(prefetch_lookahead);
+        return *huge;
+    };
+
+    std::vector<Workload> workloads{
+        {"waerden_4_5_54_sat", [&] { 
+            Propagator p(waerden_sat); 
+            return std::size_t(solve_cdcl(p)); 
+        }},
+        {"waerden_4_5_55_unsat", [&] { 
+            Propagator p(waerden_unsat); 
+            return std::size_t(solve_cdcl(p)); 
+        }},
+        {"random_3sat_120", [&] {
+            std::size_t num_sat = 0;
+            for(const ModelBuilder& model : random_3sat) {
+                Propagator p(model);
+                num_sat += solve_cdcl(p);
+            }
+            return num_sat;
+        }},
+        {"dives_3sat_100k", [&] {
+            Propagator p(large_3sat);
+            return random_dives(p, 50, 3);
+        }},
+        {"dives_60sat_2k", [&] {
+            Propagator p(long_clauses);
+            return random_dives(p, 500, 4);
+        }},
+        {"dives_200sat_2k", [&] {
+            Propagator p(very_long_clauses);
+            return random_dives(p, 200, 6);
+        }},
+        {"learnt_alo_1000", [&] {
+            // learn the at-least-one constraints, then falsify them
+            Propagator p(learnt_at_least_one);
+            std::size_t result = solve_cdcl(p);
+            p.reset_to_zero();
+            return result + negative_dives(p, 20, 12);
+        }},
+        {"probe_binary_heavy", [&] {
+            Propagator p(binary_heavy);
+            return probe_all(p);
+        }},
+        {"probe_binary_heavy_bin_first", [&] {
+            Propagator p(binary_heavy);
+            p.set_binary_first_propagation(true);
+            return probe_all(p);
+        }},
+        {"assumptions_loop", [&] {
+            Propagator p(assumption_formula);
+            return assumption_queries(p, 20000, 300, false, 15);
+        }},
+        {"assumptions_batch", [&] {
+            Propagator p(assumption_formula);
+            return assumption_queries(p, 20000, 300, true, 15);
+        }},
+        {"cdcl_deep_3sat", [&] {
+            Propagator p(deep_3sat);
+            return bounded_cdcl(p, 3000);
+        }},
+        {"cdcl_deep_3sat_chrono", [&] {
+            Propagator p(deep_3sat);
+            p.set_chronological_backtracking(100);
+            return bounded_cdcl(p, 3000);
+        }},
+        {"dives_5sat_300k", [&] {
+            return random_dives(huge_5sat(0), 3, huge_seed++);
+        }},
+        {"dives_5sat_300k_prefetch4", [&] {
+            return random_dives(huge_5sat(4), 3, huge_seed++);
+        }},
+    };
+    for(const Workload& workload : workloads) {
+        if(argc > 1 && std::strcmp(argv[1], workload.name) != 0) continue;
+        std::size_t result = 0;
+        double seconds = time_best_of(workload, 5, result);
+        std::printf("%-22s %10.4f s  (result %zu)\n", workload.name, seconds, result);
+    }
+    return EXIT_SUCCESS;
+}
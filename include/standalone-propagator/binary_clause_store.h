@@ -0,0 +1,294 @@
+#ifndef SP_BINARY_CLAUSE_STORE_H_INCLUDED_
+#define SP_BINARY_CLAUSE_STORE_H_INCLUDED_
+
+#include "types.h"
+#include "memory_usage.h"
+#include <vector>
+#include <span>
+#include <iterator>
+#include <algorithm>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Storage for binary clauses, indexed by literal.
+ * The partners of all literals are stored in a single compressed
+ * sparse row (CSR) block: the partners of literal l are
+ * m_partners[m_offsets[l]] to m_partners[m_offsets[l+1]].
+ * Binary clauses that are added after construction (e.g., learnt clauses)
+ * go into a small overflow area, which consists of one singly-linked list
+ * per literal, stored in one flat pool; it can be merged back into the CSR
+ * block on demand.
+ * Ranges of partners can be prefixed by a span of partners from another
+ * (e.g., shared and immutable) store.
+ * All memory is obtained from the given allocator (rebound as necessary).
+ */
+template<typename Allocator = std::allocator<Lit>>
+class BasicBinaryClauseStore {
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+    /**
+     * An entry in the overflow pool.
+     */
+    struct OverflowEntry {
+        Lit partner;
+        Lit next;
+    };
+
+  public:
+    /**
+     * @brief Iterator over the partners of a literal,
+     *        first in the prefix span, then in the CSR block,
+     *        then in the overflow area.
+     */
+    class PartnerIterator {
+      public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = Lit;
+        using difference_type = std::ptrdiff_t;
+
+        PartnerIterator() noexcept = default;
+
+        PartnerIterator(std::span<const Lit> prefix, std::span<const Lit> csr,
+                        const OverflowEntry* pool, Lit entry) noexcept :
+            m_prefix(prefix.data()), m_prefix_end(prefix.data() + prefix.size()),
+            m_csr(csr.data()), m_csr_end(csr.data() + csr.size()), 
+            m_pool(pool), m_entry(entry)
+        {}
+
+        Lit operator*() const noexcept {
+            if (m_prefix != m_prefix_end)
+                return *m_prefix;
+            return m_csr != m_csr_end ? *m_csr : m_pool[m_entry].partner;
+        }
+
+        PartnerIterator& operator++() noexcept {
+            if (m_prefix != m_prefix_end) {
+                ++m_prefix;
+            } else if (m_csr != m_csr_end) {
+                ++m_csr;
+            } else {
+                m_entry = m_pool[m_entry].next;
+            }
+            return *this;
+        }
+
+        PartnerIterator operator++(int) noexcept {
+            PartnerIterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return m_prefix == m_prefix_end && m_csr == m_csr_end && m_entry == NIL;
+        }
+
+      private:
+        const Lit* m_prefix{nullptr};
+        const Lit* m_prefix_end{nullptr};
+        const Lit* m_csr{nullptr};
+        const Lit* m_csr_end{nullptr};
+        const OverflowEntry* m_pool{nullptr};
+        Lit m_entry{NIL};
+    };
+
+    /**
+     * @brief Range over the partners of a literal.
+     */
+    class PartnerRange {
+      public:
+        PartnerRange(PartnerIterator begin) noexcept : m_begin(begin) {}
+
+        PartnerIterator begin() const noexcept { return m_begin; }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+      private:
+        PartnerIterator m_begin;
+    };
+
+    explicit BasicBinaryClauseStore(const Allocator& alloc = Allocator()) : 
+        m_offsets(1, 0, alloc), m_partners(alloc), m_overflow_heads(alloc), m_overflow(alloc)
+    {}
+
+    BasicBinaryClauseStore(const BasicBinaryClauseStore&) = default;
+    BasicBinaryClauseStore(BasicBinaryClauseStore&&) = default;
+    BasicBinaryClauseStore& operator=(const BasicBinaryClauseStore&) = default;
+    BasicBinaryClauseStore& operator=(BasicBinaryClauseStore&&) = default;
+
+    /**
+     * @brief Copy the given store, using the given allocator.
+     */
+    BasicBinaryClauseStore(const BasicBinaryClauseStore& other, const Allocator& alloc) :
+        m_offsets(other.m_offsets, alloc), m_partners(other.m_partners, alloc),
+        m_overflow_heads(other.m_overflow_heads, alloc), m_overflow(other.m_overflow, alloc)
+    {}
+
+    /**
+     * @brief Build the CSR block from a list of partners for each literal;
+     *        lists may be shorter than num_lits and contain duplicates.
+     */
+    void build(const std::vector<std::vector<Lit>>& partner_lists, Lit num_lits) {
+        m_offsets.assign(num_lits + 1, 0);
+        m_partners.clear();
+        m_overflow_heads.clear();
+        m_overflow.clear();
+        std::size_t total = 0;
+        for (const auto& list : partner_lists) {
+            total += list.size();
+        }
+        m_partners.reserve(total);
+        for (Lit l = 0; l < num_lits; ++l) {
+            m_offsets[l] = ClauseRef(m_partners.size());
+            if (l < partner_lists.size()) {
+                const auto& list = partner_lists[l];
+                auto begin = m_partners.insert(m_partners.end(), list.begin(), list.end());
+                std::sort(begin, m_partners.end());
+                m_partners.erase(std::unique(begin, m_partners.end()), m_partners.end());
+            }
+        }
+        p_check_csr_size(m_partners.size());
+        m_offsets[num_lits] = ClauseRef(m_partners.size());
+    }
+
+    /**
+     * @brief Add a binary clause to the overflow area.
+     */
+    void add(Lit l1, Lit l2) {
+        if (m_overflow_heads.empty()) {
+            m_overflow_heads.assign(num_lits(), NIL);
+        }
+        p_add_overflow(l1, l2);
+        p_add_overflow(l2, l1);
+    }
+
+    /**
+     * @brief Get the partners of the given literal in the CSR block.
+     */
+    std::span<const Lit> csr_partners_of(Lit l) const noexcept {
+        const Lit* data = m_partners.data();
+        return {data + m_offsets[l], data + m_offsets[l + 1]};
+    }
+
+    /**
+     * @brief Call f for each partner of the given literal in the overflow area.
+     */
+    template<typename Callable>
+    bool all_overflow_partners_of(Lit l, Callable&& f) const {
+        if (m_overflow_heads.empty())
+            return true;
+        for (Lit e = m_overflow_heads[l]; e != NIL; e = m_overflow[e].next) {
+            if (!f(m_overflow[e].partner))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get a range of all partners of the given literal,
+     *        preceded by the given prefix.
+     */
+    PartnerRange partners_of(Lit l, std::span<const Lit> prefix = {}) const noexcept {
+        Lit head = m_overflow_heads.empty() ? NIL : m_overflow_heads[l];
+        return PartnerIterator{prefix, csr_partners_of(l), m_overflow.data(), head};
+    }
+
+    /**
+     * @brief Get the number of literals.
+     */
+    Lit num_lits() const noexcept {
+        return Lit(m_offsets.size() - 1);
+    }
+
+    /**
+     * @brief Get the number of entries (two per clause) in the overflow area.
+     */
+    std::size_t overflow_size() const noexcept {
+        return m_overflow.size();
+    }
+
+    /**
+     * @brief Get the number of entries (two per clause) in the CSR block.
+     */
+    std::size_t csr_size() const noexcept {
+        return m_partners.size();
+    }
+
+    /**
+     * @brief Get the memory used by the store.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return memory_usage_of(m_offsets) + memory_usage_of(m_partners) +
+               memory_usage_of(m_overflow_heads) + memory_usage_of(m_overflow);
+    }
+
+    /**
+     * @brief Merge the overflow area into the CSR block.
+     * Linear in the total number of binary clauses.
+     */
+    void merge_overflow() {
+        if (m_overflow.empty())
+            return;
+        const Lit nl = num_lits();
+        Vector<ClauseRef> new_offsets(nl + 1, 0, m_offsets.get_allocator());
+        Vector<Lit> new_partners(m_partners.get_allocator());
+        new_partners.reserve(m_partners.size() + m_overflow.size());
+        for (Lit l = 0; l < nl; ++l) {
+            new_offsets[l] = ClauseRef(new_partners.size());
+            std::span<const Lit> csr = csr_partners_of(l);
+            new_partners.insert(new_partners.end(), csr.begin(), csr.end());
+            all_overflow_partners_of(l, [&] (Lit p) { new_partners.push_back(p); return true; });
+        }
+        p_check_csr_size(new_partners.size());
+        new_offsets[nl] = ClauseRef(new_partners.size());
+        m_offsets = std::move(new_offsets);
+        m_partners = std::move(new_partners);
+        m_overflow_heads.clear();
+        m_overflow.clear();
+    }
+
+  private:
+    /**
+     * The CSR offsets are ClauseRefs; make sure that a
+     * partner block of the given size can be indexed by them.
+     * As the offsets only grow, checking the final size suffices.
+     */
+    static void p_check_csr_size(std::size_t size) {
+        if (size > std::numeric_limits<ClauseRef>::max()) {
+            throw std::length_error("Too many binary clauses for the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
+        }
+    }
+
+    void p_add_overflow(Lit l, Lit partner) {
+        if (m_overflow.size() >= NIL) {
+            throw std::length_error("Too many learnt binary clauses for the configured index widths (see SPROP_LIT_BITS)!");
+        }
+        Lit index(m_overflow.size());
+        m_overflow.push_back(OverflowEntry{partner, m_overflow_heads[l]});
+        m_overflow_heads[l] = index;
+    }
+
+    // CSR offsets (one per literal, plus one).
+    Vector<ClauseRef> m_offsets;
+    // CSR partner block.
+    Vector<Lit> m_partners;
+    // The first overflow entry of each literal (NIL if there is none);
+    // empty as long as there are no overflow entries.
+    Vector<Lit> m_overflow_heads;
+    // The overflow pool.
+    Vector<OverflowEntry> m_overflow;
+};
+
+/**
+ * @brief Binary clause storage using the default allocator.
+ */
+using BinaryClauseStore = BasicBinaryClauseStore<>;
+
+}
+}
+
+#endif
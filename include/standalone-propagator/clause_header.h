@@ -0,0 +1,128 @@
+#ifndef SP_CLAUSE_HEADER_H_INCLUDED_
+#define SP_CLAUSE_HEADER_H_INCLUDED_
+
+#include "types.h"
+#include <algorithm>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Compact metadata of a clause of length > 2.
+ * Stored as a single word in the clause arena, directly in front of
+ * the length word of the clause, so that it can be reached from a
+ * ClauseRef without a side table.
+ * Layout (from the least significant bit):
+ *  - bit 0: learnt flag,
+ *  - bit 1: garbage flag (marked for deletion),
+ *  - bit 2: used flag (used in conflict analysis since the last reduction),
+ *  - bit 3: locked flag (temporarily set for reason clauses during reduction),
+ *  - bits 4-11: LBD (saturating),
+ *  - bits 12-31: activity (saturating).
+ * Original clauses are immutable and never deleted; for them,
+ * bits 1-31 instead hold the index of the clause among all
+ * original clauses of length > 2, and all other accessors
+ * are only meaningful for learnt clauses.
+ */
+class ClauseHeader {
+    static constexpr Lit learnt_bit = 1;
+    static constexpr Lit garbage_bit = 2;
+    static constexpr Lit used_bit = 4;
+    static constexpr Lit locked_bit = 8;
+    static constexpr unsigned lbd_shift = 4;
+    static constexpr unsigned activity_shift = 12;
+
+  public:
+    static constexpr std::uint32_t max_lbd = 0xff;
+    static constexpr std::uint32_t max_activity = 0xfffff;
+
+    /**
+     * @brief Create the header of an original clause.
+     */
+    ClauseHeader() noexcept = default;
+
+    /**
+     * @brief Reinterpret a word from the clause arena as header.
+     */
+    explicit ClauseHeader(Lit raw) noexcept : bits(raw) {}
+
+    /**
+     * @brief Create the header of the original clause with the given index.
+     */
+    static ClauseHeader original(std::uint32_t index) noexcept {
+        return ClauseHeader{Lit(index) << 1};
+    }
+
+    /**
+     * @brief Create the header of a learnt clause with the given LBD.
+     */
+    static ClauseHeader learnt(std::uint32_t lbd) noexcept {
+        ClauseHeader result{learnt_bit};
+        result.set_lbd(lbd);
+        return result;
+    }
+
+    /**
+     * @brief Get the raw word that is stored in the clause arena.
+     */
+    Lit raw() const noexcept { return bits; }
+
+    bool is_learnt() const noexcept { return bits & learnt_bit; }
+
+    /**
+     * @brief Get the index of an original clause.
+     */
+    std::uint32_t original_index() const noexcept { return bits >> 1; }
+
+    bool is_garbage() const noexcept { return bits & garbage_bit; }
+    bool is_used() const noexcept { return bits & used_bit; }
+    bool is_locked() const noexcept { return bits & locked_bit; }
+
+    void set_garbage(bool v) noexcept { p_set_flag(garbage_bit, v); }
+    void set_used(bool v) noexcept { p_set_flag(used_bit, v); }
+    void set_locked(bool v) noexcept { p_set_flag(locked_bit, v); }
+
+    std::uint32_t lbd() const noexcept {
+        return (bits >> lbd_shift) & max_lbd;
+    }
+
+    void set_lbd(std::uint32_t lbd) noexcept {
+        lbd = (std::min)(lbd, max_lbd);
+        bits = (bits & ~(Lit(max_lbd) << lbd_shift)) | (Lit(lbd) << lbd_shift);
+    }
+
+    std::uint32_t activity() const noexcept {
+        return bits >> activity_shift;
+    }
+
+    /**
+     * @brief Increase the activity by one (saturating).
+     */
+    void bump_activity() noexcept {
+        if (activity() < max_activity) {
+            bits += Lit(1) << activity_shift;
+        }
+    }
+
+    /**
+     * @brief Halve the activity.
+     */
+    void decay_activity() noexcept {
+        Lit new_activity = activity() >> 1;
+        bits = (bits & ((Lit(1) << activity_shift) - 1)) | (new_activity << activity_shift);
+    }
+
+  private:
+    void p_set_flag(Lit flag, bool v) noexcept {
+        bits = v ? (bits | flag) : (bits & ~flag);
+    }
+
+    Lit bits{0};
+};
+
+static_assert(sizeof(ClauseHeader) == sizeof(Lit), "clause header must fit into one arena word");
+
+}
+}
+
+#endif
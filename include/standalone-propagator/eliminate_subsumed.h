@@ -5,6 +5,7 @@
 #include "types.h"
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
  * @brief Class to implement elimination of subsumed clauses
@@ -101,6 +102,7 @@ inline void eliminate_subsumed(std::vector<ClauseType>& clauses, Var n_all) {
     subsumption_checker.remove_subsumed();
 }
 
+}
 }
 
 #endif
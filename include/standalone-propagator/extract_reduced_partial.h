@@ -6,8 +6,10 @@
 #include "types.h"
 #include "propagator.h"
 #include "eliminate_subsumed.h"
+#include "memory_usage.h"
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 static inline constexpr Lit FIXED_TRUE = NIL - 1;
 static inline constexpr Lit FIXED_FALSE = NIL - 2;
@@ -22,12 +24,29 @@ static inline constexpr Lit FIXED_FALSE = NIL - 2;
  */
 class ReducedPartialExtractor {
   public:
+    /**
+     * @brief Breakdown of the memory used by a ReducedPartialExtractor.
+     */
+    struct MemoryBreakdown {
+        // The fixed-literal flags and the literal translation maps.
+        MemoryUsage literal_maps;
+        // The reduced clauses.
+        MemoryUsage reduced_clauses;
+        // Auxiliary buffers.
+        MemoryUsage buffers;
+
+        MemoryUsage total() const noexcept {
+            return literal_maps + reduced_clauses + buffers;
+        }
+    };
+
     ReducedPartialExtractor() = default;
 
     /**
      * @brief Extracts the reduced formula from the given propagator.
      */
-    inline void extract(const Propagator& propagator);
+    template<typename Allocator>
+    inline void extract(const BasicPropagator<Allocator>& propagator);
 
     /**
      * @brief Returns the reduced clauses.
@@ -67,6 +86,18 @@ class ReducedPartialExtractor {
         return m_old_to_new[old];
     }
 
+    /**
+     * @brief Get the memory currently used by the extractor.
+     */
+    MemoryBreakdown memory_usage() const noexcept {
+        return MemoryBreakdown{
+            memory_usage_of(m_old_lit_is_true) + memory_usage_of(m_old_lit_is_false) +
+                memory_usage_of(m_new_to_old) + memory_usage_of(m_old_to_new),
+            memory_usage_of(m_reduced_clauses),
+            memory_usage_of(m_new_clause_buffer)
+        };
+    }
+
   private:
     // Is the given old literal true?
     std::vector<bool> m_old_lit_is_true;
@@ -88,7 +119,8 @@ class ReducedPartialExtractor {
     // Buffer for new clauses.
     std::vector<Lit> m_new_clause_buffer;
 
-    void p_init_extraction(const Propagator& propagator) {
+    template<typename Allocator>
+    void p_init_extraction(const BasicPropagator<Allocator>& propagator) {
         std::size_t nv = propagator.num_vars();
         std::size_t nl = 2 * nv;
         m_old_lit_is_false.assign(nl, false);
@@ -124,7 +156,8 @@ class ReducedPartialExtractor {
         }
     }
 
-    void p_translate_binaries(const Propagator& propagator) {
+    template<typename Allocator>
+    void p_translate_binaries(const BasicPropagator<Allocator>& propagator) {
         // translate binaries:
         for(Lit l1 : propagator.all_literals()) {
             if(m_old_lit_is_false[l1]) {
@@ -158,7 +191,8 @@ class ReducedPartialExtractor {
         m_reduced_clauses.push_back(m_new_clause_buffer);
     }
 
-    void p_translate_clauses(const Propagator& propagator) {
+    template<typename Allocator>
+    void p_translate_clauses(const BasicPropagator<Allocator>& propagator) {
         // no need to translate unaries!
         p_translate_binaries(propagator);
         // translate longer clauses:
@@ -170,13 +204,15 @@ class ReducedPartialExtractor {
     }
 };
 
-void ReducedPartialExtractor::extract(const Propagator& propagator) {
+template<typename Allocator>
+void ReducedPartialExtractor::extract(const BasicPropagator<Allocator>& propagator) {
     p_init_extraction(propagator);
     p_make_literal_maps();
     p_translate_clauses(propagator);
     eliminate_subsumed(m_reduced_clauses, reduced_num_vars());
 }
 
+}
 }
 
 #endif
@@ -5,6 +5,7 @@
 #include <vector>
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 namespace lit {
 
 /**
@@ -89,6 +90,7 @@ static inline bool is_false_in(Lit l, const BitsetType& assignment) noexcept
     return !is_true_in(l, assignment);
 }
 
+}
 }
 }
 
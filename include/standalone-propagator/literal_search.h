@@ -0,0 +1,194 @@
+#ifndef SP_LITERAL_SEARCH_H_INCLUDED_
+#define SP_LITERAL_SEARCH_H_INCLUDED_
+
+#include "types.h"
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * If defined to 1, searches for non-false literals in long clauses
+ * use AVX2/AVX-512 gather kernels when the CPU supports them
+ * (selected at runtime); requires x86 and GCC or Clang.
+ * Defaults to 0: on the benchmark workloads, replacements are
+ * usually found among the first few literals, and the kernels
+ * did not yield a measurable end-to-end gain.
+ */
+#ifndef SPROP_SIMD_LITERAL_SEARCH
+#define SPROP_SIMD_LITERAL_SEARCH 0
+#endif
+
+/**
+ * If defined to 1 (and SIMD literal search is enabled), the AVX-512 kernel
+ * is preferred over the AVX2 kernel on CPUs that support both.
+ * Defaults to 0: replacements are usually found within the first few
+ * literals checked, where the wider gather mostly adds latency.
+ */
+#ifndef SPROP_SIMD_LITERAL_SEARCH_AVX512
+#define SPROP_SIMD_LITERAL_SEARCH_AVX512 0
+#endif
+
+#if SPROP_SIMD_LITERAL_SEARCH
+#include <immintrin.h>
+#endif
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Searches for literals that are not false in ranges of
+ *        literals, given a per-literal value array (1 true, 0 open, -1 false).
+ * The value array must be padded to a multiple of 4 entries,
+ * as the vectorized kernels read the aligned 4-byte group of each value.
+ */
+class LiteralSearch {
+  public:
+    using KernelFunction = const Lit* (*)(const Lit*, const Lit*, const std::int8_t*) noexcept;
+
+    /**
+     * @brief Ranges with at least this many literals are
+     *        searched by the vectorized kernel (if available).
+     */
+    static constexpr std::size_t simd_threshold = 16;
+
+    /**
+     * @brief The number of literals at the beginning of long ranges that
+     *        are checked one by one, as replacements are often found early.
+     */
+    static constexpr std::size_t scalar_prefix = 8;
+
+    /**
+     * @brief Get the number of value array entries needed for the given number of literals.
+     */
+    static constexpr std::size_t padded_size(std::size_t num_lits) noexcept {
+        return (num_lits + 3) & ~std::size_t(3);
+    }
+
+    /**
+     * @brief Find the first literal in [begin, end) that is not false;
+     *        return end if there is none.
+     */
+    static const Lit* find_non_false(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+#if SPROP_SIMD_LITERAL_SEARCH
+        if (std::size_t(end - begin) >= simd_threshold) {
+            const Lit* prefix_end = begin + scalar_prefix;
+            const Lit* result = find_non_false_scalar(begin, prefix_end, values);
+            return result != prefix_end ? result : p_kernel()(prefix_end, end, values);
+        }
+#endif
+        return find_non_false_scalar(begin, end, values);
+    }
+
+    static Lit* find_non_false(Lit* begin, Lit* end, const std::int8_t* values) noexcept {
+        return const_cast<Lit*>(find_non_false(static_cast<const Lit*>(begin),
+                                               static_cast<const Lit*>(end), values));
+    }
+
+    /**
+     * @brief The scalar search; also handles the tails of the vectorized kernels.
+     */
+    static const Lit* find_non_false_scalar(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+        for (; begin != end; ++begin) {
+            if (values[*begin] >= 0)
+                return begin;
+        }
+        return end;
+    }
+
+    /**
+     * @brief The name of the kernel selected for this CPU ("avx512", "avx2" or "scalar").
+     */
+    static const char* kernel_name() noexcept {
+#if SPROP_SIMD_LITERAL_SEARCH
+        if constexpr (sizeof(Lit) == 4) {
+#if SPROP_SIMD_LITERAL_SEARCH_AVX512
+            if (p_kernel() == &p_find_non_false_avx512)
+                return "avx512";
+#endif
+            if (p_kernel() == &p_find_non_false_avx2)
+                return "avx2";
+        }
+#endif
+        return "scalar";
+    }
+
+  private:
+#if SPROP_SIMD_LITERAL_SEARCH
+    /**
+     * Check 8 literals at a time: gather the aligned 4-byte group
+     * containing each value (indices lit / 4 are non-negative even for
+     * literals >= 2^31), shift the value into the top byte and
+     * collect the sign bits, which mark false literals.
+     */
+    __attribute__((target("avx2")))
+    static const Lit* p_find_non_false_avx2(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+        const __m256i three = _mm256_set1_epi32(3);
+        for (; end - begin >= 8; begin += 8) {
+            __m256i lits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            __m256i groups = _mm256_i32gather_epi32(reinterpret_cast<const int*>(values),
+                                                    _mm256_srli_epi32(lits, 2), 4);
+            __m256i shift = _mm256_slli_epi32(_mm256_andnot_si256(lits, three), 3);
+            __m256i top = _mm256_sllv_epi32(groups, shift);
+            unsigned non_false = ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(top))) & 0xffu;
+            if (non_false) {
+                return begin + __builtin_ctz(non_false);
+            }
+        }
+        return find_non_false_scalar(begin, end, values);
+    }
+
+#if SPROP_SIMD_LITERAL_SEARCH_AVX512
+    /**
+     * Like the AVX2 kernel, but checking 16 literals at a time.
+     * Uses the zero-masking forms of the intrinsics with a full mask;
+     * the unmasked forms pass an undefined source that GCC warns about.
+     */
+    __attribute__((target("avx512f")))
+    static const Lit* p_find_non_false_avx512(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+        const __mmask16 all = 0xffff;
+        const __m512i three = _mm512_set1_epi32(3);
+        const __m512i zero = _mm512_setzero_si512();
+        for (; end - begin >= 16; begin += 16) {
+            __m512i lits = _mm512_loadu_si512(begin);
+            __m512i indices = _mm512_maskz_srli_epi32(all, lits, 2);
+            __m512i groups = _mm512_mask_i32gather_epi32(zero, all, indices, values, 4);
+            __m512i shift = _mm512_maskz_slli_epi32(all, _mm512_maskz_andnot_epi32(all, lits, three), 3);
+            __m512i top = _mm512_maskz_sllv_epi32(all, groups, shift);
+            unsigned non_false = _mm512_cmpge_epi32_mask(top, zero);
+            if (non_false) {
+                return begin + __builtin_ctz(non_false);
+            }
+        }
+        return find_non_false_scalar(begin, end, values);
+    }
+#endif
+#endif
+
+    static KernelFunction p_select_kernel() noexcept {
+#if SPROP_SIMD_LITERAL_SEARCH
+        if constexpr (sizeof(Lit) == 4) {
+            __builtin_cpu_init();
+#if SPROP_SIMD_LITERAL_SEARCH_AVX512
+            if (__builtin_cpu_supports("avx512f"))
+                return &p_find_non_false_avx512;
+#endif
+            if (__builtin_cpu_supports("avx2"))
+                return &p_find_non_false_avx2;
+        }
+#endif
+        return &find_non_false_scalar;
+    }
+
+    /**
+     * The kernel for long ranges, selected once for the running CPU
+     * (on first use, so that it is also available during static initialization).
+     */
+    static KernelFunction p_kernel() noexcept {
+        static const KernelFunction kernel = p_select_kernel();
+        return kernel;
+    }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef SP_MAPPED_ARENA_H_INCLUDED_
+#define SP_MAPPED_ARENA_H_INCLUDED_
+
+#include "types.h"
+#include "memory_usage.h"
+#include <cstring>
+#include <new>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * If defined to 1, the clause arenas of the propagator
+ * (original and learnt clauses) are MappedArenas instead of vectors.
+ * Only available on POSIX systems; the arenas then do not use the
+ * allocator of the propagator.
+ */
+#ifndef SPROP_MAPPED_CLAUSE_ARENA
+#define SPROP_MAPPED_CLAUSE_ARENA 0
+#endif
+
+#if SPROP_MAPPED_CLAUSE_ARENA
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief A vector-like container for trivially copyable elements,
+ *        backed by an anonymous memory mapping.
+ * The arena reserves a range of address space (without committing memory;
+ * pages are committed by the kernel when they are first written) and
+ * requests transparent huge pages for it where available.
+ * Growing within the reservation never moves the elements; growing beyond it
+ * doubles the reservation, which on Linux remaps the existing pages instead
+ * of copying them. Shrinking returns the pages beyond the new size to the system.
+ */
+template<typename T>
+class MappedArena {
+    static_assert(std::is_trivially_copyable_v<T>, "mapped arena elements must be trivially copyable");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief The initial amount of address space reserved (in bytes).
+     */
+    static constexpr std::size_t initial_reservation = std::size_t(64) << 20;
+
+    MappedArena() noexcept = default;
+
+    /**
+     * @brief For compatibility with allocator-aware containers;
+     *        the allocator is ignored.
+     */
+    template<typename Allocator>
+    explicit MappedArena(const Allocator&) noexcept {}
+
+    MappedArena(const MappedArena& other) {
+        p_assign(other);
+    }
+
+    MappedArena(MappedArena&& other) noexcept {
+        p_swap(other);
+    }
+
+    MappedArena& operator=(const MappedArena& other) {
+        if (this != &other) {
+            p_assign(other);
+        }
+        return *this;
+    }
+
+    MappedArena& operator=(MappedArena&& other) noexcept {
+        MappedArena tmp(std::move(other));
+        p_swap(tmp);
+        return *this;
+    }
+
+    ~MappedArena() {
+        if (m_base) {
+            ::munmap(m_base, m_reserved);
+        }
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief The number of elements that fit into the reserved address space.
+     */
+    std::size_t capacity() const noexcept { return m_reserved / sizeof(T); }
+
+    T* data() noexcept { return static_cast<T*>(m_base); }
+    const T* data() const noexcept { return static_cast<const T*>(m_base); }
+    T* begin() noexcept { return data(); }
+    const T* begin() const noexcept { return data(); }
+    T* end() noexcept { return data() + m_size; }
+    const T* end() const noexcept { return data() + m_size; }
+    T& operator[](std::size_t i) noexcept { return data()[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+
+    void reserve(std::size_t n) {
+        if (n > capacity()) {
+            p_reserve_bytes(n * sizeof(T));
+        }
+    }
+
+    void push_back(const T& value) {
+        if (m_size == capacity()) {
+            p_reserve_bytes((m_size + 1) * sizeof(T));
+        }
+        data()[m_size++] = value;
+    }
+
+    /**
+     * @brief Insert the elements of [first, last) before pos.
+     */
+    template<typename ForwardIterator>
+    T* insert(const T* pos, ForwardIterator first, ForwardIterator last) {
+        std::size_t offset = std::size_t(pos - data());
+        std::size_t count = std::size_t(std::distance(first, last));
+        reserve(m_size + count);
+        T* at = data() + offset;
+        std::memmove(at + count, at, (m_size - offset) * sizeof(T));
+        std::copy(first, last, at);
+        m_size += count;
+        return at;
+    }
+
+    void resize(std::size_t n) {
+        if (n > m_size) {
+            reserve(n);
+            std::fill(data() + m_size, data() + n, T{});
+        } else {
+            p_release_pages_from(n * sizeof(T));
+        }
+        m_size = n;
+    }
+
+    void clear() noexcept {
+        p_release_pages_from(0);
+        m_size = 0;
+    }
+
+    /**
+     * @brief Get the memory used by the arena; reserved counts
+     *        the reserved address space, not committed memory.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return MemoryUsage{m_size * sizeof(T), m_reserved};
+    }
+
+  private:
+    static std::size_t p_page_size() noexcept {
+        static const std::size_t page_size = std::size_t(::sysconf(_SC_PAGESIZE));
+        return page_size;
+    }
+
+    void p_reserve_bytes(std::size_t bytes) {
+        std::size_t new_reserved = (std::max)(m_reserved, initial_reservation);
+        while (new_reserved < bytes) {
+            new_reserved *= 2;
+        }
+        if (new_reserved == m_reserved)
+            return;
+        void* new_base = MAP_FAILED;
+        if (!m_base) {
+            new_base = ::mmap(nullptr, new_reserved, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        } else {
+#if defined(__linux__)
+            new_base = ::mremap(m_base, m_reserved, new_reserved, MREMAP_MAYMOVE);
+#else
+            new_base = ::mmap(nullptr, new_reserved, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (new_base != MAP_FAILED) {
+                std::memcpy(new_base, m_base, m_size * sizeof(T));
+                ::munmap(m_base, m_reserved);
+            }
+#endif
+        }
+        if (new_base == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+#if defined(MADV_HUGEPAGE)
+        ::madvise(new_base, new_reserved, MADV_HUGEPAGE);
+#endif
+        m_base = new_base;
+        m_reserved = new_reserved;
+    }
+
+    void p_release_pages_from(std::size_t bytes) noexcept {
+        if (!m_base)
+            return;
+        std::size_t page = p_page_size();
+        std::size_t first_page = (bytes + page - 1) / page * page;
+        std::size_t used_end = (m_size * sizeof(T) + page - 1) / page * page;
+        if (first_page < used_end) {
+            ::madvise(static_cast<char*>(m_base) + first_page, used_end - first_page, MADV_DONTNEED);
+        }
+    }
+
+    void p_assign(const MappedArena& other) {
+        clear();
+        reserve(other.m_size);
+        if (other.m_size) {
+            std::memcpy(m_base, other.m_base, other.m_size * sizeof(T));
+        }
+        m_size = other.m_size;
+    }
+
+    void p_swap(MappedArena& other) noexcept {
+        std::swap(m_base, other.m_base);
+        std::swap(m_size, other.m_size);
+        std::swap(m_reserved, other.m_reserved);
+    }
+
+    // The beginning of the mapping (nullptr if nothing is reserved).
+    void* m_base{nullptr};
+    // The number of elements.
+    std::size_t m_size{0};
+    // The number of bytes of reserved address space.
+    std::size_t m_reserved{0};
+};
+
+/**
+ * @brief Get the memory used by a mapped arena.
+ */
+template<typename T>
+MemoryUsage memory_usage_of(const MappedArena<T>& arena) noexcept {
+    return arena.memory_usage();
+}
+
+}
+}
+
+#endif
+
+#endif
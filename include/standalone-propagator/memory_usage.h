@@ -0,0 +1,71 @@
+#ifndef SP_MEMORY_USAGE_H_INCLUDED_
+#define SP_MEMORY_USAGE_H_INCLUDED_
+
+#include "types.h"
+#include <cstddef>
+#include <climits>
+#include <vector>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief The dynamic memory used by a data structure, in bytes.
+ * Used bytes are occupied by elements; reserved bytes are all
+ * bytes currently allocated (i.e., used bytes plus capacity slack).
+ */
+struct MemoryUsage {
+    std::size_t used{0};
+    std::size_t reserved{0};
+
+    /**
+     * @brief The number of bytes that are allocated but not used.
+     */
+    std::size_t slack() const noexcept { return reserved - used; }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) noexcept {
+        used += other.used;
+        reserved += other.reserved;
+        return *this;
+    }
+
+    friend MemoryUsage operator+(MemoryUsage a, const MemoryUsage& b) noexcept {
+        return a += b;
+    }
+};
+
+/**
+ * @brief Get the memory used by the elements of a vector.
+ */
+template<typename T, typename Allocator>
+MemoryUsage memory_usage_of(const std::vector<T, Allocator>& v) noexcept {
+    return MemoryUsage{v.size() * sizeof(T), v.capacity() * sizeof(T)};
+}
+
+/**
+ * @brief Get the memory used by a bit vector.
+ */
+template<typename Allocator>
+MemoryUsage memory_usage_of(const std::vector<bool, Allocator>& v) noexcept {
+    return MemoryUsage{(v.size() + CHAR_BIT - 1) / CHAR_BIT,
+                       (v.capacity() + CHAR_BIT - 1) / CHAR_BIT};
+}
+
+/**
+ * @brief Get the memory used by a vector of vectors,
+ *        including the memory of the inner vectors.
+ */
+template<typename T, typename InnerAllocator, typename Allocator>
+MemoryUsage memory_usage_of(const std::vector<std::vector<T, InnerAllocator>, Allocator>& v) noexcept {
+    using Inner = std::vector<T, InnerAllocator>;
+    MemoryUsage result{v.size() * sizeof(Inner), v.capacity() * sizeof(Inner)};
+    for (const Inner& inner : v) {
+        result += memory_usage_of(inner);
+    }
+    return result;
+}
+
+}
+}
+
+#endif
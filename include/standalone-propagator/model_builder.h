@@ -4,13 +4,16 @@
 #include "types.h"
 #include "unsat_exception.h"
 #include "literal_ops.h"
+#include "memory_usage.h"
 #include <algorithm>
 #include <string>
 #include <format>
 #include <sstream>
+#include <span>
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
  * @brief A class that helps building a SAT formula.
@@ -18,8 +21,22 @@ namespace sprop {
  */
 class ModelBuilder {
   public:
-    friend class Propagator;
+    template<typename Allocator> friend class BasicPropagator;
     
+    /**
+     * @brief Breakdown of the memory used by a ModelBuilder.
+     */
+    struct MemoryBreakdown {
+        MemoryUsage unary_clauses;
+        MemoryUsage binary_clauses;
+        MemoryUsage longer_clauses;
+        MemoryUsage buffers;
+
+        MemoryUsage total() const noexcept {
+            return unary_clauses + binary_clauses + longer_clauses + buffers;
+        }
+    };
+
     ModelBuilder() = default;
 
     /**
@@ -95,7 +112,7 @@ class ModelBuilder {
     /**
      * Verify that the given trail is a valid assignment for the model.
      */
-    std::optional<std::string> verify_trail(const std::vector<Lit>& full_trail) {
+    std::optional<std::string> verify_trail(std::span<const Lit> full_trail) {
         auto n = lit::var(m_current_lit);
         if(full_trail.size() != n) {
             return std::format("Trail has wrong length: expected {}, got {}", n, full_trail.size());
@@ -158,6 +175,18 @@ class ModelBuilder {
         return std::nullopt;
     }
 
+    /**
+     * @brief Get the memory currently used by the model.
+     */
+    MemoryBreakdown memory_usage() const noexcept {
+        return MemoryBreakdown{
+            memory_usage_of(m_unary_clauses),
+            memory_usage_of(m_binary_clauses),
+            memory_usage_of(m_longer_clauses),
+            memory_usage_of(m_current_clause_buffer)
+        };
+    }
+
   private:
     /**
      * Add the current clause to the model and clear it.
@@ -212,6 +241,7 @@ class ModelBuilder {
     std::vector<Lit> m_current_clause_buffer;
 };
 
+}
 }
 
 #endif
@@ -3,11 +3,63 @@
 
 #include "types.h"
 #include "reason.h"
+#include "clause_header.h"
+#include "binary_clause_store.h"
+#include "ternary_clause_store.h"
 #include "model_builder.h"
+#include "memory_usage.h"
+#include "slab_list_store.h"
+#include "mapped_arena.h"
+#include "literal_search.h"
 #include <cassert>
+#include <stdexcept>
 #include <optional>
+#include <memory>
+#include <array>
+#include <functional>
+#include <vector>
+#include <memory_resource>
+#include <span>
+
+/**
+ * If defined to 1, binary clauses are not kept in a separate
+ * BinaryClauseStore; instead, they are stored as tagged entries
+ * in the same watch lists as the watchers of longer clauses.
+ */
+#ifndef SPROP_INLINE_BINARY_WATCHERS
+#define SPROP_INLINE_BINARY_WATCHERS 0
+#endif
+
+/**
+ * The default number of watchers ahead of the current one for which
+ * propagation prefetches clause memory (see set_prefetch_lookahead).
+ * Defaults to 0 (off), as prefetching slows down propagation
+ * on formulas that fit into the cache.
+ */
+#ifndef SPROP_DEFAULT_PREFETCH_LOOKAHEAD
+#define SPROP_DEFAULT_PREFETCH_LOOKAHEAD 0
+#endif
+
+/**
+ * Learnt clauses of at least this length remember where the last
+ * search for a replacement watch found one, in an extra word after
+ * their literals; the next search continues from there circularly
+ * instead of restarting after the watched literals, which keeps
+ * repeated visits of long clauses from becoming quadratic.
+ * (Original clauses always do this, using their watch slot.)
+ */
+#ifndef SPROP_SAVED_SEARCH_MIN_LENGTH
+#define SPROP_SAVED_SEARCH_MIN_LENGTH 16
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SPROP_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define SPROP_PREFETCH(address) ((void)(address))
+#endif
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 namespace detail {
 
 /**
@@ -16,13 +68,13 @@ namespace detail {
 class VariableState {
     std::int32_t value_code{-1};
     std::uint32_t stamp{0};
-    std::uint32_t trail_pos{NIL};
+    TrailLen trail_pos{std::numeric_limits<TrailLen>::max()};
 
   public:
     /**
      * @brief Get the trail position of the variable.
      */
-    std::uint32_t get_trail_pos() const noexcept { return trail_pos; }
+    TrailLen get_trail_pos() const noexcept { return trail_pos; }
 
     /**
      * @brief Get the current stamp value of the variable.
@@ -37,7 +89,7 @@ class VariableState {
     /**
      * @brief Assign a value to the variable at a certain level.
      */
-    void assign(std::uint32_t tpos, Lit ltrue, std::int32_t level) {
+    void assign(TrailLen tpos, Lit ltrue, std::int32_t level) {
         value_code = (level << 1) + std::int32_t(ltrue & 1);
         trail_pos = tpos;
     }
@@ -107,7 +159,7 @@ class VariableState {
  * @brief Information about a decision level in the propagator.
  */
 class LevelInfo {
-    std::uint32_t trail_pos;
+    TrailLen trail_pos;
     std::uint32_t stamp{0};
 
   public:
@@ -115,57 +167,159 @@ class LevelInfo {
 
     void stamp_with(std::uint32_t v) noexcept { stamp = v; }
 
-    std::uint32_t level_begin() const noexcept { return trail_pos; }
+    TrailLen level_begin() const noexcept { return trail_pos; }
 
-    explicit LevelInfo(std::uint32_t trail_pos) noexcept
+    explicit LevelInfo(TrailLen trail_pos) noexcept
         : trail_pos(trail_pos) {}
 };
 
+/**
+ * @brief The container type of clause arenas.
+ */
+#if SPROP_MAPPED_CLAUSE_ARENA
+template<typename Allocator>
+using ClauseArena = MappedArena<Lit>;
+#else
+template<typename Allocator>
+using ClauseArena = std::vector<Lit, Allocator>;
+#endif
+
+/**
+ * @brief The original (irredundant) clauses of a formula.
+ * Immutable after construction and shared by all copies of a propagator.
+ */
+template<typename Allocator>
+struct OriginalFormula {
+    explicit OriginalFormula(const Allocator& alloc) : 
+        binary_clauses(alloc), ternary_clauses(alloc), clause_db(alloc) 
+    {}
+
+    // The original binary clauses.
+    BasicBinaryClauseStore<Allocator> binary_clauses;
+    // Occurrence lists of the clauses of length 3, used for propagating them.
+    BasicTernaryClauseStore<Allocator> ternary_clauses;
+    // Clauses of length > 2, each stored as [header, length, literals...];
+    // a ClauseRef is the index of the first literal.
+    ClauseArena<Allocator> clause_db;
+    // The number of clauses in clause_db.
+    std::size_t num_clauses{0};
+    // The number of clauses of length 3 in clause_db.
+    std::size_t num_ternary_clauses{0};
+};
+
 } // namespace detail
 
 /**
  * @brief A propagator for a SAT formula.
+ * All internal data structures obtain their memory from an allocator
+ * of the given type (rebound as necessary); use Propagator for the
+ * default allocator and pmr::Propagator for a std::pmr::memory_resource.
  */
-class Propagator {
+template<typename Allocator = std::allocator<Lit>>
+class BasicPropagator {
     using VariableState = detail::VariableState;
     using LevelInfo = detail::LevelInfo;
+    using LitAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Lit>;
+    using OriginalFormula = detail::OriginalFormula<LitAllocator>;
+
+  public:
+    /**
+     * @brief The allocator type used by the propagator.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief The vector type used for the internal data structures,
+     *        some of which are exposed by reference.
+     */
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  private:
 
     /**
      * A watcher for a clause.
      * Each clause watches two literals;
-     * these are rearranged so that the watched
-     * literals are the first two literals in the clause.
+     * for learnt clauses, these are rearranged so that the watched
+     * literals are the first two literals in the clause, and the
+     * watcher refers to the clause by its ClauseRef.
+     * Original clauses are shared and immutable; original clauses of length 3
+     * are not watched, but propagated through the shared occurrence lists in
+     * OriginalFormula::ternary_clauses. For longer original clauses, the watched
+     * literals are kept in a per-instance OriginalWatch slot instead,
+     * and the watcher refers to the index of that slot (which is
+     * always below m_learnt_begin), so that propagation reaches the
+     * watched literals without going through the clause.
      * The blocker is a watched literal and helps us
      * avoid accesses into the large clause array.
+     * With SPROP_INLINE_BINARY_WATCHERS, binary clauses are
+     * represented by watchers with the clause binary_tag;
+     * their blocker is the other literal of the clause.
      */
     struct Watcher {
         Lit blocker;
         ClauseRef clause;
+
+        static constexpr ClauseRef binary_tag = NIL_CLAUSE;
+
+        bool is_binary() const noexcept { return clause == binary_tag; }
+    };
+
+    /**
+     * The watched literals of an original clause of length > 3
+     * in this propagator, together with the clause's ClauseRef
+     * and the position at which the next replacement search starts.
+     */
+    struct OriginalWatch {
+        std::array<Lit, 2> watched;
+        ClauseRef clause;
+        Lit search_pos;
     };
 
-    using WatchList = std::vector<Watcher>;
-    using WatchIter = WatchList::iterator;
+    static constexpr bool inline_binary_watchers = SPROP_INLINE_BINARY_WATCHERS;
+    static constexpr ClauseLen saved_search_min_length = SPROP_SAVED_SEARCH_MIN_LENGTH;
+
+    // all watch lists, stored in a single slab
+    using WatchStore = SlabListStore<Watcher, Allocator>;
   
   public:
     // -------- CONSTRUCTION --------
     /**
      * Create a new propagator without any clauses or variables.
      */
-    inline explicit Propagator();
+    inline explicit BasicPropagator(const Allocator& alloc = Allocator());
 
     /**
      * Create a new propagator from a model/formula.
      */
-    inline explicit Propagator(const ModelBuilder& model);
+    inline explicit BasicPropagator(const ModelBuilder& model, const Allocator& alloc = Allocator());
 
     /**
      * Propagators are copyable/movable.
-     * Copies are essentially linear in the size of the entire structure.
+     * Copies share the (immutable) original clauses; they are essentially 
+     * linear in the number of variables, watchers and learnt clauses.
+     * Copies obtain their allocator as the standard containers do;
+     * for std::pmr, this means that they use the default memory resource.
+     */
+    BasicPropagator(const BasicPropagator&) = default;
+    BasicPropagator(BasicPropagator&&) = default;
+    BasicPropagator& operator=(const BasicPropagator&) = default;
+    BasicPropagator& operator=(BasicPropagator&&) = default;
+
+    /**
+     * Create a copy of the given propagator that uses the given allocator,
+     * e.g., to place a short-lived copy into an arena.
+     * The shared original clauses remain where they are; the allocator of
+     * the propagator they were created by must outlive the copy.
+     */
+    inline BasicPropagator(const BasicPropagator& other, const Allocator& alloc);
+
+    /**
+     * @brief Get the allocator of the propagator.
      */
-    Propagator(const Propagator&) = default;
-    Propagator(Propagator&&) = default;
-    Propagator& operator=(const Propagator&) = default;
-    Propagator& operator=(Propagator&&) = default;
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(trail_lits.get_allocator());
+    }
 
     /// -------- ACCESS OF CLAUSES AND LITERALS --------
     /**
@@ -174,14 +328,21 @@ class Propagator {
      */
     ClauseRef cref_of(ClausePtrRange lits) const noexcept {
         assert(std::distance(lits.begin(), lits.end()) > 2);
-        return ClauseRef(lits.begin() - m_large_clause_db.data());
+        const Lit* begin = lits.begin();
+        const auto& original_db = m_original->clause_db;
+        if (std::less_equal<const Lit*>{}(original_db.data(), begin) &&
+            std::less<const Lit*>{}(begin, original_db.data() + original_db.size()))
+        {
+            return ClauseRef(begin - original_db.data());
+        }
+        return ClauseRef(begin - m_learnt_clause_db.data()) + m_learnt_begin - 2;
     }
 
     /**
      * @brief Get the literals of a clause longer than 2.
      */
     ClausePtrRange lits_of(ClauseRef clause) const noexcept {
-        const Lit* begin = m_large_clause_db.data() + clause;
+        const Lit* begin = p_clause_begin(clause);
         return std::ranges::subrange(begin, begin + begin[-1]);
     }
 
@@ -189,35 +350,80 @@ class Propagator {
      * @brief Get the length of a clause (in literals).
      */
     ClauseLen clause_length(ClauseRef clause) const noexcept {
-        return m_large_clause_db[clause - 1];
+        return p_clause_begin(clause)[-1];
+    }
+
+    /**
+     * @brief Get the metadata header of a clause longer than 2.
+     */
+    ClauseHeader header_of(ClauseRef clause) const noexcept {
+        return ClauseHeader{p_clause_begin(clause)[-2]};
+    }
+
+    /**
+     * @brief Check whether a clause longer than 2 is a learnt clause.
+     */
+    bool is_learnt(ClauseRef clause) const noexcept {
+        return header_of(clause).is_learnt();
     }
 
     /**
      * @brief From a clause reference, get the next higher clause reference.
      */
     ClauseRef next_clause(ClauseRef clause) const noexcept {
-        return clause + m_large_clause_db[clause - 1] + 1;
+        ClauseLen length = p_clause_begin(clause)[-1];
+        return clause + length + 2 + (clause >= m_learnt_begin && p_has_saved_search(length));
     }
 
     /**
      * @brief Get a range of all literals in unary clauses.
      */
-    const std::vector<Lit>& unary_clauses() const noexcept {
+    const Vector<Lit>& unary_clauses() const noexcept {
         return m_unary_clauses;
     }
 
     /**
      * @brief Get a range of all literals that occur together with the given literal in a binary clause.
+     * This is an input range (it is neither sized nor random-access); partners
+     * from original binary clauses come first and are free of duplicates.
+     */
+    auto binary_partners_of(Lit lit) const noexcept {
+        if constexpr (inline_binary_watchers) {
+            return watchers[lit]
+                | std::views::filter([] (const Watcher& w) { return w.is_binary(); })
+                | std::views::transform([] (const Watcher& w) { return w.blocker; });
+        } else {
+            return m_binary_clauses.partners_of(lit, m_original->binary_clauses.csr_partners_of(lit));
+        }
+    }
+
+    /**
+     * @brief Get the literals that occur together with the given literal in an
+     *        original (i.e., not learnt) binary clause, sorted and without duplicates.
+     * The span refers to the shared original formula and remains valid
+     * as long as the propagator or any of its copies exists.
      */
-    const std::vector<Lit>& binary_partners_of(Lit lit) const noexcept {
-        return m_binary_clauses[lit];
+    std::span<const Lit> original_binary_partners_of(Lit lit) const noexcept {
+        return m_original->binary_clauses.csr_partners_of(lit);
+    }
+
+    /**
+     * @brief Merge the binary clauses learnt since construction (or since
+     * the last merge) into the compact block of learnt binary clauses.
+     * This happens automatically once there are as many new learnt binary
+     * clauses as merged ones (or at least 1024); it invalidates all ranges
+     * obtained from binary_partners_of.
+     * Does nothing with SPROP_INLINE_BINARY_WATCHERS.
+     */
+    void merge_learnt_binaries() {
+        m_binary_clauses.merge_overflow();
     }
 
     /**
      * @brief Get the ClauseRef of the first clause of length > 2.
      */
     ClauseRef first_longer_clause() const noexcept {
-        return 1;
+        return 2;
     }
 
     /**
@@ -225,7 +431,7 @@ class Propagator {
      * i.e., what would be returned by next_clause(last_clause).
      */
     ClauseRef longer_clause_end() const noexcept {
-        return m_large_clause_db.size() + 1;
+        return m_learnt_begin + ClauseRef(m_learnt_clause_db.size());
     }
 
     /**
@@ -262,8 +468,7 @@ class Propagator {
      * @return false
      */
     bool is_true(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_true(literal);
+        return m_lit_values[literal] > 0;
     }
 
     /**
@@ -275,8 +480,7 @@ class Propagator {
      * @return false
      */
     bool is_false(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_false(literal);
+        return m_lit_values[literal] < 0;
     }
 
     /**
@@ -288,8 +492,7 @@ class Propagator {
      * @return false
      */
     bool is_open_or_true(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_open_or_true(literal);
+        return m_lit_values[literal] >= 0;
     }
 
     /**
@@ -301,16 +504,15 @@ class Propagator {
      * @return false
      */
     bool is_open(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_open();
+        return m_lit_values[literal] == 0;
     }
 
     /**
      * @brief Get the list of literals that are currently assigned to true.
      *
-     * @return const std::vector<Lit>&
+     * @return const Vector<Lit>&
      */
-    const std::vector<Lit>& get_trail() const noexcept { 
+    const Vector<Lit>& get_trail() const noexcept { 
         return trail_lits; 
     }
 
@@ -360,7 +562,7 @@ class Propagator {
     /**
      * @brief Get the list of reasons for the literals that are currently assigned to true.
      */
-    const std::vector<Reason>&  get_reasons() const noexcept {
+    const Vector<Reason>&  get_reasons() const noexcept {
         return trail_reasons; 
     }
 
@@ -382,15 +584,17 @@ class Propagator {
 
     /**
      * @brief Get an iterator to the beginning of the current level in the trail.
+     * With chronological backtracking (see set_chronological_backtracking),
+     * the trail segment of a level may also contain assignments of lower levels.
      */
-    std::vector<Lit>::const_iterator current_level_begin() const noexcept {
+    Vector<Lit>::const_iterator current_level_begin() const noexcept {
         return trail_lits.begin() + levels.back().level_begin();
     }
 
     /**
      * @brief Get an iterator to the beginning of the current level in the trail reasons.
      */
-    std::vector<Reason>::const_iterator current_level_reasons_begin() const noexcept {
+    Vector<Reason>::const_iterator current_level_reasons_begin() const noexcept {
         return trail_reasons.begin() + levels.back().level_begin();
     }
 
@@ -398,9 +602,9 @@ class Propagator {
      * @brief Get an iterator to the beginning of the given level in the trail.
      *
      * @param level
-     * @return std::vector<Lit>::const_iterator
+     * @return Vector<Lit>::const_iterator
      */
-    std::vector<Lit>::const_iterator level_begin(std::uint32_t level) const {
+    Vector<Lit>::const_iterator level_begin(std::uint32_t level) const {
         return trail_lits.begin() + levels[level].level_begin();
     }
 
@@ -408,9 +612,9 @@ class Propagator {
      * @brief Get an iterator to the end of the given level in the trail.
      *
      * @param level
-     * @return std::vector<Lit>::const_iterator
+     * @return Vector<Lit>::const_iterator
      */
-    std::vector<Lit>::const_iterator level_end(std::uint32_t level) const {
+    Vector<Lit>::const_iterator level_end(std::uint32_t level) const {
         if (level >= levels.size() - 1)
             return trail_lits.end();
         return trail_lits.begin() + levels[level + 1].level_begin();
@@ -437,13 +641,13 @@ class Propagator {
      * Compute a list of [Level, Literal] pairs of decisions
      * that ultimately led to including l in the trail.
      */
-    inline const std::vector<std::pair<std::int32_t,Lit>> &decisions_leading_to(Lit l);
+    inline const Vector<std::pair<std::int32_t,Lit>> &decisions_leading_to(Lit l);
 
     /*
      * Compute a list of [Level, Literal] pairs of decisions
      * that ultimately led to the current conflict.
      */
-    inline const std::vector<std::pair<std::int32_t,Lit>>& decisions_leading_to_conflict();
+    inline const Vector<std::pair<std::int32_t,Lit>>& decisions_leading_to_conflict();
 
     // -------- PROPAGATION --------
     /**
@@ -467,22 +671,35 @@ class Propagator {
      */
     inline bool push_level(Lit decision);
 
+    /**
+     * @brief Push a sequence of assumptions, each as a decision on its own level,
+     * stopping at the first assumption that fails.
+     * Assumptions that are already true are skipped without creating a level.
+     * An assumption fails if it is already false (in which case the propagator
+     * is not conflicting and the assumption is not pushed) or if its
+     * propagation leads to a conflict (in which case is_conflicting() is true,
+     * as after push_level). Throws if the propagator is already conflicting.
+     *
+     * @return The index of the failed assumption, or assumptions.size()
+     *         if all assumptions hold.
+     */
+    inline std::size_t push_assumptions(std::span<const Lit> assumptions);
+
     /**
      * @brief Pop the highest decision level without learning.
      * There is no need for a conflict to use this method.
      * On conflict, it should be preferred to call resolve_conflicts instead,
      * but pop_level will also clear the conflict.
+     * With chronological backtracking, assignments of lower levels placed
+     * on the popped level are kept and propagated again; if the popped
+     * level was not the level of the conflict, the conflict may persist.
      */
     inline void pop_level();
 
     /**
      * Reset propagator to level 0.
      */
-    void reset_to_zero() noexcept {
-        while(get_current_level() > 0) {
-            pop_level();
-        }
-    }
+    inline void reset_to_zero();
 
     /**
      * @brief Resolve a conflict by learning a clause and jumping back
@@ -494,7 +711,10 @@ class Propagator {
      *
      * In any case, all assignments on the current level are undone because
      * its decision led to a conflict; this is *NOT* reported to the given
-     * AssignmentHandler.
+     * AssignmentHandler. With chronological backtracking
+     * (see set_chronological_backtracking), assignments of lower levels are
+     * only undone if they are above the conflict level or the asserting
+     * literal is placed on the level directly below it.
      *
      * However, all assignments on lower levels that are undone or forced by
      * this action *ARE* reported. After learning a conflict clause and jumping
@@ -530,6 +750,120 @@ class Propagator {
         if(!resolve_conflicts()) throw UNSATException();
     }
 
+    // -------- LEARNT CLAUSE MANAGEMENT --------
+    /**
+     * @brief Get the number of learnt clauses of length > 2
+     *        that are currently in the clause database.
+     */
+    std::size_t num_learnt_clauses() const noexcept {
+        return m_num_learnt;
+    }
+
+    /**
+     * @brief Delete the weaker half of the learnt clauses of length > 2.
+     * Learnt clauses are scored by recent use in conflict analysis,
+     * their LBD (literal block distance) and their activity;
+     * clauses with LBD <= 2, clauses of length 3 (whose reasons do not
+     * refer to them, so their use is not tracked) and clauses that are
+     * currently the reason for an assignment are never deleted.
+     * Afterwards, the clause database is compacted;
+     * this invalidates all ClauseRefs to learnt clauses held outside
+     * of the propagator (including copies of Reasons).
+     */
+    inline void reduce_learnts();
+
+    /**
+     * @brief Automatically call reduce_learnts() from resolve_conflicts()
+     * whenever the given number of clauses of length > 2 have been
+     * learnt since the last reduction. 0 (the default) disables
+     * automatic reduction.
+     */
+    void set_learnt_reduction_interval(std::size_t interval) noexcept {
+        m_reduction_interval = interval;
+    }
+
+    /**
+     * @brief Restore the locality of the watch lists, which are stored
+     * in a single slab, by laying them out contiguously in literal order;
+     * also releases the blocks freed by growing watch lists.
+     * Useful after heavy conflict learning or after reduce_learnts().
+     */
+    void compact_watches() {
+        watchers.compact();
+    }
+
+    // -------- TUNING --------
+    /**
+     * @brief Set the number k of watchers ahead of the current one for
+     * which propagation through longer clauses issues prefetches:
+     * for the watch slot or learnt clause of the watcher k positions ahead,
+     * and for the blocker value and original clause literals of the
+     * watcher k/2 positions ahead; also prefetches the watch list of the
+     * next literal to propagate. 0 (the default) disables prefetching.
+     * Helps on formulas that do not fit into the last-level cache
+     * (values between 4 and 8 work well); costs time on smaller formulas.
+     */
+    void set_prefetch_lookahead(std::uint32_t lookahead) noexcept {
+        m_prefetch_lookahead = lookahead;
+    }
+
+    /**
+     * @brief Get the prefetch lookahead (see set_prefetch_lookahead).
+     */
+    std::uint32_t get_prefetch_lookahead() const noexcept {
+        return m_prefetch_lookahead;
+    }
+
+    /**
+     * @brief Enable or disable binary-first propagation.
+     * By default, each literal on the trail is propagated through the binary
+     * clauses and then through the longer clauses before the next literal.
+     * In binary-first mode, propagation keeps two positions on the trail and
+     * exhausts all binary implications before visiting the clauses of length > 2
+     * of the next literal, so that conflicts among binary clauses are found
+     * without touching the clause database. This changes the order of the trail,
+     * but not the set of assigned literals or whether a conflict is found.
+     * Has no effect with SPROP_INLINE_BINARY_WATCHERS.
+     */
+    void set_binary_first_propagation(bool binary_first) noexcept {
+        m_binary_first = binary_first;
+        m_binary_queue_head = trail_queue_head;
+    }
+
+    /**
+     * @brief Check whether binary-first propagation is enabled (see set_binary_first_propagation).
+     */
+    bool get_binary_first_propagation() const noexcept {
+        return m_binary_first;
+    }
+
+    /**
+     * @brief Use chronological backtracking in resolve_conflicts when jumping
+     * back to the asserting level would undo more than max_jump levels.
+     * In that case, only the conflict level is undone, and the asserting
+     * literal of the learnt clause is assigned out of order, on the highest level
+     * among the other literals of the clause; the assignments on the levels in
+     * between are kept instead of being propagated again. The trail is then no
+     * longer sorted by level, and conflicts may occur below the current level;
+     * resolve_conflicts first backtracks to the level of the conflict.
+     * The default (always_backjump) disables chronological backtracking.
+     */
+    void set_chronological_backtracking(std::uint32_t max_jump) noexcept {
+        m_chrono_max_jump = max_jump;
+    }
+
+    /**
+     * @brief Get the maximum backjump distance (see set_chronological_backtracking).
+     */
+    std::uint32_t get_chronological_backtracking() const noexcept {
+        return m_chrono_max_jump;
+    }
+
+    /**
+     * @brief The value of set_chronological_backtracking that disables it.
+     */
+    static constexpr std::uint32_t always_backjump = (std::numeric_limits<std::uint32_t>::max)();
+
     // -------- RESULT EXTRACTION --------
     /**
      * @brief Extract an assignment as bit-vector, where result[i] == true means
@@ -537,28 +871,83 @@ class Propagator {
      */
     inline std::vector<bool> extract_assignment() const;
 
+    // -------- MEMORY USAGE --------
+    /**
+     * @brief Breakdown of the memory used by a propagator.
+     */
+    struct MemoryBreakdown {
+        // The original clauses (long and binary); 
+        // shared by all copies of a propagator.
+        MemoryUsage original_clauses;
+        // The arena of learnt clauses of length > 2.
+        MemoryUsage learnt_clauses;
+        // The watch lists (including the watched literals of original clauses).
+        MemoryUsage watch_lists;
+        // The learnt binary clauses.
+        MemoryUsage binary_clauses;
+        // The trail literals, reasons and level information.
+        MemoryUsage trail;
+        // The variable states.
+        MemoryUsage variables;
+        // Unary clauses and auxiliary buffers.
+        MemoryUsage buffers;
+
+        /**
+         * @brief The total memory used by the propagator,
+         *        excluding the shared original clauses.
+         */
+        MemoryUsage total_unshared() const noexcept {
+            return learnt_clauses + watch_lists + binary_clauses + 
+                   trail + variables + buffers;
+        }
+
+        MemoryUsage total() const noexcept {
+            return original_clauses + total_unshared();
+        }
+    };
+
+    /**
+     * @brief Get the memory currently used by the propagator.
+     */
+    inline MemoryBreakdown memory_usage() const noexcept;
+
   private:
     // -------- FORMULA DATA --------
-    std::vector<Lit> m_unary_clauses;
-    std::vector<std::vector<Lit>> m_binary_clauses;
-    std::vector<Lit> m_large_clause_db;
+    // The original binary and long clauses, shared by all copies.
+    std::shared_ptr<const OriginalFormula> m_original;
+    Vector<Lit> m_unary_clauses;
+    // The learnt binary clauses.
+    BasicBinaryClauseStore<LitAllocator> m_binary_clauses;
+    // Learnt clauses of length > 2, in the same format as the original
+    // clauses; the clause with ClauseRef c begins at c - m_learnt_begin + 2.
+    // Clauses with a saved search position are followed by that position.
+    detail::ClauseArena<LitAllocator> m_learnt_clause_db;
+    // The watch slots of the original clauses of length > 3.
+    Vector<OriginalWatch> m_original_watches;
     Var m_num_vars;
 
     // -------- VARIABLE/LITERAL STATE --------
     // The state of our variables.
-    std::vector<VariableState> variables;
+    Vector<VariableState> variables;
+    // The value of each literal (1: true, 0: open, -1: false),
+    // kept in sync with variables for fast checks during propagation;
+    // padded for the vectorized replacement search.
+    Vector<std::int8_t> m_lit_values;
     // For each literal, a list of watchers.
-    std::vector<WatchList> watchers;
+    WatchStore watchers;
 
     // -------- TRAIL --------
     // The literals on the trail.
-    std::vector<Lit> trail_lits;
+    Vector<Lit> trail_lits;
     // The reasons on the trail.
-    std::vector<Reason> trail_reasons;
+    Vector<Reason> trail_reasons;
     // The levels of the trail.
-    std::vector<LevelInfo> levels;
+    Vector<LevelInfo> levels;
     // The index of the next literal to propagate on.
     std::size_t trail_queue_head{0};
+    // In binary-first mode, the index of the next literal to propagate
+    // on through binary clauses (trail_queue_head <= m_binary_queue_head).
+    std::size_t m_binary_queue_head{0};
 
     // -------- CONFLICT INFORMATION --------
     // The reason for the current conflict.
@@ -574,20 +963,84 @@ class Propagator {
 
     // -------- AUXILIARY BUFFERS --------
     // Buffer for building a learnt clause
-    std::vector<Lit> learn_buffer;
+    Vector<Lit> learn_buffer;
     // Buffer for supporting decisions of a literal.
-    std::vector<std::pair<std::int32_t,Lit>> supporting_decision_buffer;
+    Vector<std::pair<std::int32_t,Lit>> supporting_decision_buffer;
+
+    // -------- LEARNT CLAUSE INFORMATION --------
+    // The ClauseRef of the first learnt clause of length > 2;
+    // all clauses before it are original clauses (in m_original).
+    ClauseRef m_learnt_begin{2};
+    // The number of learnt clauses of length > 2.
+    std::size_t m_num_learnt{0};
+    // The number of learnt clauses between automatic reductions (0: never).
+    std::size_t m_reduction_interval{0};
+    // The number of clauses learnt since the last reduction.
+    std::size_t m_learnts_since_reduction{0};
+
+    // -------- TUNING --------
+    // The number of watchers to prefetch ahead (0: no prefetching).
+    std::uint32_t m_prefetch_lookahead{SPROP_DEFAULT_PREFETCH_LOOKAHEAD};
+    // Whether all binary implications are propagated before longer clauses.
+    bool m_binary_first{false};
+    // Backjumps over more levels are replaced by chronological backtracking.
+    std::uint32_t m_chrono_max_jump{always_backjump};
 
 
     // ----------------- IMPLEMENTATION BEYOND THIS POINT -----------------
     /**
-     * @brief Get the literals of a clause longer than 2.
+     * @brief Get a pointer to the first literal of a clause longer than 2.
+     */
+    const Lit* p_clause_begin(ClauseRef clause) const noexcept {
+        if (clause < m_learnt_begin)
+            return m_original->clause_db.data() + clause;
+        return m_learnt_clause_db.data() + (clause - m_learnt_begin + 2);
+    }
+
+    /**
+     * @brief Get the literals of a learnt clause longer than 2.
      */
     MutClausePtrRange mut_lits_of(ClauseRef clause) noexcept {
-        Lit* begin = m_large_clause_db.data() + clause;
+        assert(clause >= m_learnt_begin);
+        Lit* begin = m_learnt_clause_db.data() + (clause - m_learnt_begin + 2);
         return std::ranges::subrange(begin, begin + begin[-1]);
     }
 
+    /**
+     * @brief Overwrite the metadata header of a learnt clause longer than 2.
+     */
+    void p_set_header(ClauseRef clause, ClauseHeader header) noexcept {
+        assert(clause >= m_learnt_begin);
+        m_learnt_clause_db[clause - m_learnt_begin] = header.raw();
+    }
+
+    /**
+     * @brief Check whether clauses of the given length keep a saved search position.
+     */
+    static constexpr bool p_has_saved_search(ClauseLen length) noexcept {
+        return length >= saved_search_min_length;
+    }
+
+    /**
+     * @brief Append a learnt clause with the given header to the clause database.
+     */
+    template<typename LitRange>
+    ClauseRef p_append_learnt_clause(ClauseHeader header, const LitRange& literals) {
+        ClauseRef ref = m_learnt_begin + ClauseRef(m_learnt_clause_db.size());
+        auto length = ClauseLen(std::ranges::size(literals));
+        if (NIL_CLAUSE - ref <= std::size_t(length) + 3) {
+            throw std::length_error("Learnt clauses exceed the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
+        }
+        m_learnt_clause_db.push_back(header.raw());
+        m_learnt_clause_db.push_back(length);
+        m_learnt_clause_db.insert(m_learnt_clause_db.end(), std::ranges::begin(literals), std::ranges::end(literals));
+        if (p_has_saved_search(length)) {
+            // the search for a replacement of the watched literals starts after them
+            m_learnt_clause_db.push_back(2);
+        }
+        return ref;
+    }
+
     /**
      * Assign the given literal to true at decision level 0.
      * Return false if this leads to a conflict.
@@ -596,6 +1049,7 @@ class Propagator {
         VariableState& vstate = variables[lit::var(forced_true)];
         if (vstate.is_open()) {
             vstate.assign(trail_lits.size(), forced_true, 0);
+            p_set_true(forced_true);
             trail_lits.push_back(forced_true);
             trail_reasons.push_back(Reason::Unary{forced_true});
         } else {
@@ -616,10 +1070,28 @@ class Propagator {
                      Lit literal, ReasonType&& reason) 
     {
         vstate.assign(trail_lits.size(), literal, level);
+        p_set_true(literal);
         trail_lits.push_back(literal);
         trail_reasons.emplace_back(std::forward<ReasonType>(reason));
     }
 
+    /**
+     * Set the value of the given literal to true (and its negation to false).
+     */
+    void p_set_true(Lit literal) noexcept {
+        m_lit_values[literal] = 1;
+        m_lit_values[lit::negate(literal)] = -1;
+    }
+
+    /**
+     * Make the variable of the given literal open.
+     */
+    void p_make_open(Lit literal) noexcept {
+        variables[lit::var(literal)].make_open();
+        m_lit_values[literal] = 0;
+        m_lit_values[lit::negate(literal)] = 0;
+    }
+
     /**
      * Initialize level 0 with the unary clauses.
      */
@@ -653,11 +1125,10 @@ class Propagator {
      * Insert a new long clause into the watch lists,
      * unless it is satisfied, forcing or conflicting at level 0.
      */
-    void p_new_long_clause_on_construction(ClauseRef ref, MutClausePtrRange literals) {
-        Lit *new_first[2];
+    void p_new_long_clause_on_construction(ClauseRef ref, ClauseRef slot, ClausePtrRange literals) {
+        const Lit *new_first[2];
         std::int32_t nws = 0;
-        Lit* lit_array = literals.begin();
-        for(Lit* current = lit_array, *end = literals.end(); current != end; ++current) {
+        for(const Lit* current = literals.begin(), *end = literals.end(); current != end; ++current) {
             Lit l = *current;
             VariableState& vstate = variables[lit::var(l)];
             auto s = vstate.state(l);
@@ -677,7 +1148,7 @@ class Propagator {
         if(nws == 0) { 
             // violated at level 0 - conflict, UNSAT
             conflicting = true;
-            conflict_reason = Reason::Clause{ClauseLen(literals.size()), ref};
+            conflict_reason = p_clause_reason(ref);
             return;
         }
         if(nws == 1) {
@@ -687,13 +1158,12 @@ class Propagator {
             p_assign_at_0(forced_true);
             return;
         }
-        // move the watched literals to the front
-        std::swap(*new_first[0], lit_array[0]);
-        std::swap(*new_first[1], lit_array[1]);
+        // remember the watched literals (the clause itself is immutable)
+        Lit w1 = *new_first[0], w2 = *new_first[1];
+        m_original_watches[slot] = OriginalWatch{{w1, w2}, ref, 0};
         // install watchers
-        Lit w1 = lit_array[0], w2 = lit_array[1];
-        watchers[w1].push_back(Watcher{w2, ref});
-        watchers[w2].push_back(Watcher{w1, ref});
+        watchers.push_back(w1, Watcher{w2, slot});
+        watchers.push_back(w2, Watcher{w1, slot});
     }
 
     /**
@@ -703,69 +1173,117 @@ class Propagator {
         p_init_unaries();
         if(conflicting) return;
         watchers.resize(2 * m_num_vars);
-        for(ClauseRef ref = first_longer_clause(); ref < longer_clause_end(); ref = next_clause(ref)) {
-            MutClausePtrRange literals = mut_lits_of(ref);
-            p_new_long_clause_on_construction(ref, literals);
+        m_original_watches.assign(m_original->num_clauses - m_original->num_ternary_clauses, 
+                                  OriginalWatch{{NIL, NIL}, NIL_CLAUSE, 0});
+        ClauseRef next_slot = 0;
+        for(ClauseRef ref = first_longer_clause(); ref < m_learnt_begin; ref = next_clause(ref)) {
+            ClausePtrRange literals = lits_of(ref);
+            // clauses of length 3 are propagated through the occurrence lists
+            // (which also handles them at level 0, during the initial propagation)
+            if(literals.size() == 3) continue;
+            p_new_long_clause_on_construction(ref, next_slot++, literals);
             if(conflicting) return;
         }
         p_init_binary_watches();
     }
 
     /**
-     * Process the short clauses.
+     * Set up the storage for learnt binary clauses; with 
+     * SPROP_INLINE_BINARY_WATCHERS, also import the original binary
+     * clauses into the watch lists.
      */
-    void p_process_short_clauses() {
-        for(auto& list : m_binary_clauses) {
-            std::sort(list.begin(), list.end());
-            list.erase(std::unique(list.begin(), list.end()), list.end());
+    void p_import_binary_clauses(const std::vector<std::vector<Lit>>& partner_lists) {
+        if constexpr (inline_binary_watchers) {
+            watchers.resize(2 * m_num_vars);
+            std::vector<Lit> partners;
+            for (Lit l = 0; l < partner_lists.size(); ++l) {
+                partners = partner_lists[l];
+                std::sort(partners.begin(), partners.end());
+                partners.erase(std::unique(partners.begin(), partners.end()), partners.end());
+                for (Lit p : partners) {
+                    watchers.push_back(l, Watcher{p, Watcher::binary_tag});
+                }
+            }
+        } else {
+            m_binary_clauses.build({}, 2 * m_num_vars);
         }
-        m_binary_clauses.resize(m_num_vars * 2);
     }
 
     /**
-     * Import the longer clauses.
+     * Create the shared original formula from the given model.
      */
-    void p_import_large_clauses(const std::vector<std::vector<Lit>>& clauses) {
+    static std::shared_ptr<const OriginalFormula> 
+        p_make_original_formula(const ModelBuilder& model, const Allocator& alloc) 
+    {
+        LitAllocator lit_alloc(alloc);
+        auto formula = std::allocate_shared<OriginalFormula>(lit_alloc, lit_alloc);
+        formula->binary_clauses.build(model.m_binary_clauses, lit::absolute(model.m_current_lit));
+        formula->ternary_clauses.build(model.m_longer_clauses, lit::absolute(model.m_current_lit));
         std::size_t total_size = 0;
-        for(const auto& clause : clauses) {
-            total_size += clause.size() + 1;
+        for(const auto& clause : model.m_longer_clauses) {
+            total_size += clause.size() + 2;
         }
-        m_large_clause_db.reserve(std::size_t(std::round(total_size * 1.5)));
-        for(const auto& clause : clauses) {
-            m_large_clause_db.push_back(ClauseLen(clause.size()));
-            m_large_clause_db.insert(m_large_clause_db.end(), clause.begin(), clause.end());
+        if (model.m_longer_clauses.size() > (NIL >> 1) || 
+            total_size >= std::size_t(NIL_CLAUSE) - 2) 
+        {
+            throw std::length_error("Too many clauses for the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
         }
+        auto& db = formula->clause_db;
+        db.reserve(total_size);
+        for(const auto& clause : model.m_longer_clauses) {
+            formula->num_ternary_clauses += (clause.size() == 3);
+            db.push_back(ClauseHeader::original(std::uint32_t(formula->num_clauses++)).raw());
+            db.push_back(ClauseLen(clause.size()));
+            db.insert(db.end(), clause.begin(), clause.end());
+        }
+        return formula;
     }
 
     /**
-     * Roll back the current decision level; if report is set,
-     * report undone assignments to the given handler.
+     * Roll back all decision levels above the target level.
+     * Undone assignments at trail positions below known_end are reported
+     * to the handler (in reverse trail order). After chronological
+     * backtracking, the rolled-back part of the trail may contain assignments
+     * of levels <= target; these are kept, moved down in trail order and
+     * queued for propagation again, as their consequences on the rolled-back
+     * levels are undone. known_end is updated to the end of the assignments
+     * that remain known to the handler.
      */
     template <typename AssignmentHandler>
-    void p_rollback_level(AssignmentHandler& handler, bool report) {
-        if (levels.back().level_begin() == 0) {
-            for (auto i = trail_lits.rbegin(), e = trail_lits.rend(); i != e; ++i) {
-                Lit l = *i;
-                if (report)
-                    handler.assignment_undone(l);
-                variables[lit::var(l)].make_open();
+    void p_rollback_level(AssignmentHandler& handler, std::int32_t target, std::size_t& known_end) {
+        const std::size_t begin = levels[target + 1].level_begin();
+        bool kept = false;
+        for (std::size_t i = trail_lits.size(); i-- > begin;) {
+            Lit l = trail_lits[i];
+            if (variables[lit::var(l)].level() <= target) {
+                kept = true;
+                continue;
             }
-            trail_lits.clear();
-            trail_reasons.clear();
-        } else {
-            auto current_end =
-                trail_lits.begin() + (levels.back().level_begin() - 1);
-            auto current_begin = trail_lits.end() - 1;
-            for (; current_begin != current_end; --current_begin) {
-                trail_reasons.pop_back();
-                Lit l = *current_begin;
-                if (report)
-                    handler.assignment_undone(l);
-                variables[lit::var(l)].make_open();
+            if (i < known_end)
+                handler.assignment_undone(l);
+            p_make_open(l);
+        }
+        std::size_t out = begin;
+        std::size_t new_known_end = (std::min)(known_end, begin);
+        if (kept) {
+            for (std::size_t i = begin, e = trail_lits.size(); i != e; ++i) {
+                Lit l = trail_lits[i];
+                VariableState& vs = variables[lit::var(l)];
+                if (vs.is_open())
+                    continue;
+                vs.assign(TrailLen(out), l, vs.level());
+                trail_lits[out] = l;
+                trail_reasons[out] = trail_reasons[i];
+                ++out;
+                new_known_end += (i < known_end);
             }
-            trail_lits.erase(current_end + 1, trail_lits.end());
         }
-        levels.pop_back();
+        trail_lits.erase(trail_lits.begin() + out, trail_lits.end());
+        trail_reasons.erase(trail_reasons.begin() + out, trail_reasons.end());
+        levels.erase(levels.begin() + (target + 1), levels.end());
+        known_end = new_known_end;
+        trail_queue_head = (std::min)(trail_queue_head, begin);
+        m_binary_queue_head = (std::min)(m_binary_queue_head, begin);
     }
 
     /**
@@ -782,12 +1300,11 @@ class Propagator {
      * Return false on conflict.
      */
     bool p_propagate_binary(Lit lfalse, Lit other, std::int32_t level) {
-        Lit v = lit::var(other);
-        VariableState& vs = variables[v];
-        if (vs.is_open()) {
-            p_assign_at(vs, level, other, Reason::Binary{lfalse, other});
+        std::int8_t value = m_lit_values[other];
+        if (value == 0) {
+            p_assign_at(variables[lit::var(other)], level, other, Reason::Binary{lfalse, other});
         } else {
-            if (vs.is_false(other)) {
+            if (value < 0) {
                 conflicting = true;
                 conflict_reason = Reason::Binary{lfalse, other};
                 conflict_lit = other;
@@ -801,28 +1318,176 @@ class Propagator {
      * Propagate a new decision or consequence through binary clauses.
      */
     bool p_propagate_through_binaries(Lit ltrue) {
+        if constexpr (inline_binary_watchers) {
+            // handled in p_propagate_through_longer
+            return true;
+        }
         Lit lfalse = lit::negate(ltrue);
         auto level = std::int32_t(levels.size() - 1);
-        for (Lit other : binary_partners_of(lfalse)) {
+        for (Lit other : m_original->binary_clauses.csr_partners_of(lfalse)) {
+            if(!p_propagate_binary(lfalse, other, level))
+                return false;
+        }
+        for (Lit other : m_binary_clauses.csr_partners_of(lfalse)) {
             if(!p_propagate_binary(lfalse, other, level))
                 return false;
         }
+        return m_binary_clauses.all_overflow_partners_of(lfalse, [&] (Lit other) {
+            return p_propagate_binary(lfalse, other, level);
+        });
+    }
+
+    /**
+     * Propagate a new decision or consequence through the
+     * original clauses of length 3, using their occurrence lists.
+     */
+    bool p_propagate_through_ternaries(Lit ltrue) {
+        Lit lfalse = lit::negate(ltrue);
+        auto level = std::int32_t(levels.size() - 1);
+        const std::int8_t* values = m_lit_values.data();
+        for (const auto& [a, b] : m_original->ternary_clauses.occurrences_of(lfalse)) {
+            std::int8_t va = values[a], vb = values[b];
+            if (va > 0 || vb > 0 || (va == 0 && vb == 0))
+                continue;
+            if (va < 0 && vb < 0) {
+                conflicting = true;
+                conflict_lit = a;
+                conflict_reason = Reason::Ternary{a, lfalse, b};
+                return false;
+            }
+            Lit forced = va == 0 ? a : b;
+            Lit other = va == 0 ? b : a;
+            p_assign_at(variables[lit::var(forced)], level, forced, Reason::Ternary{forced, lfalse, other});
+        }
         return true;
     }
 
     /**
-     * Check if *watcher_in has a true blocker.
-     * In that case, copy it to *watcher_out and advance both.
+     * Check if ws[watcher_in] has a true blocker.
+     * In that case, copy it to ws[watcher_out] and advance both.
      * Otherwise, simply return false.
      */
-    bool p_has_true_blocker(WatchIter& watcher_in, WatchIter& watcher_out) {
-        if (is_true(watcher_in->blocker)) {
-            *watcher_out++ = *watcher_in++;
+    bool p_has_true_blocker(Watcher* ws, std::size_t& watcher_in, std::size_t& watcher_out) {
+        if (is_true(ws[watcher_in].blocker)) {
+            ws[watcher_out++] = ws[watcher_in++];
             return true;
         }
         return false;
     }
 
+    /**
+     * Prefetch the memory needed to process the given watcher
+     * (its watch slot or learnt clause) if its blocker is not true.
+     */
+    void p_prefetch_watcher(const Watcher& w) const noexcept {
+        if (w.clause < m_learnt_begin) {
+            SPROP_PREFETCH(&m_original_watches[w.clause]);
+        } else if (!w.is_binary()) {
+            SPROP_PREFETCH(p_clause_begin(w.clause) - 2);
+        }
+    }
+
+    /**
+     * Second prefetch stage for a watcher, after the first stage
+     * had time to bring in its watch slot: prefetch the blocker value
+     * and, for original clauses, the literals at the position
+     * where the next replacement search starts.
+     */
+    void p_prefetch_clause(const Watcher& w) const noexcept {
+        SPROP_PREFETCH(&m_lit_values[w.blocker]);
+        if (w.clause >= m_learnt_begin)
+            return;
+        const OriginalWatch& slot = m_original_watches[w.clause];
+        SPROP_PREFETCH(m_original->clause_db.data() + slot.clause + slot.search_pos);
+    }
+
+    /**
+     * For a clause in which lfalse is watched (given as the clause
+     * member of its watcher), get a pointer to the
+     * two watched literals, arranged such that lfalse is the second one.
+     * For learnt clauses, these are the first two literals of the clause;
+     * for original clauses, they are in the clause's watch slot.
+     */
+    Lit* p_watched_pair(ClauseRef watched_clause, Lit lfalse) noexcept {
+        Lit* pair = watched_clause < m_learnt_begin ? 
+            m_original_watches[watched_clause].watched.data() :
+            mut_lits_of(watched_clause).begin();
+        if (pair[0] == lfalse) {
+            std::swap(pair[0], pair[1]);
+        }
+        return pair;
+    }
+
+    /**
+     * Search the original clause with the given watch slot for an open or
+     * true literal that is not watched, to replace its false watched literal.
+     * The clause is immutable, so instead of moving literals, the search
+     * continues circularly from where the last replacement was found.
+     * On success, update the slot and return the replacement.
+     * Otherwise, return NIL.
+     */
+    Lit p_find_original_replacement(ClauseRef slot_index) {
+        OriginalWatch& slot = m_original_watches[slot_index];
+        // slot.watched[1] is false, so only the other watched literal must be skipped
+        Lit first = slot.watched[0];
+        const Lit* begin = p_clause_begin(slot.clause);
+        const Lit* end = begin + begin[-1];
+        const Lit* start = begin + slot.search_pos;
+        const std::int8_t* values = m_lit_values.data();
+        auto search = [&] (const Lit* from, const Lit* to) {
+            const Lit* r = LiteralSearch::find_non_false(from, to, values);
+            if (r != to && *r == first)
+                r = LiteralSearch::find_non_false(r + 1, to, values);
+            return r;
+        };
+        const Lit* replacement = search(start, end);
+        if (replacement == end) {
+            replacement = search(begin, start);
+            if (replacement == start)
+                return NIL;
+        }
+        slot.search_pos = Lit(replacement - begin);
+        slot.watched[1] = *replacement;
+        return *replacement;
+    }
+
+    /**
+     * Search the given learnt clause for an open or true literal that
+     * is not watched, to replace the false watched literal pair[1];
+     * on success, move it to pair[1] and return it.
+     * Otherwise, return NIL.
+     * For clauses with a saved search position, the search continues
+     * circularly from the position of the last replacement (where the
+     * false literal it replaced now is), and that position is updated.
+     */
+    Lit p_find_learnt_replacement(Lit* pair) {
+        // search the rest of the clause for an open or true literal
+        ClauseLen length = pair[-1];
+        Lit* lit_end = pair + length;
+        const std::int8_t* values = m_lit_values.data();
+        Lit* replacement;
+        if (!p_has_saved_search(length)) {
+            replacement = LiteralSearch::find_non_false(pair + 2, lit_end, values);
+            if (replacement == lit_end)
+                return NIL;
+        } else {
+            Lit& search_pos = *lit_end;
+            Lit* start = pair + search_pos;
+            replacement = LiteralSearch::find_non_false(start, lit_end, values);
+            if (replacement == lit_end) {
+                replacement = LiteralSearch::find_non_false(pair + 2, start, values);
+                if (replacement == start)
+                    return NIL;
+            }
+            search_pos = Lit(replacement - pair);
+        }
+        // move it to pair[1]
+        Lit repl = *replacement;
+        *replacement = pair[1];
+        pair[1] = repl;
+        return repl;
+    }
+
     /**
      * Propagate a new decision or consequence through longer clauses.
      * Return false on conflict.
@@ -837,68 +1502,123 @@ class Propagator {
     bool p_propagate_through_longer(Lit ltrue) {
         Lit lfalse = lit::negate(ltrue);
         auto level = std::int32_t(levels.size() - 1);
-        WatchList& ws = watchers[lfalse];
-        WatchIter watcher_in = ws.begin();
-        WatchIter watcher_out = ws.begin(); 
-        WatchIter watcher_end = ws.end();
+        // installing new watchers may move the watch slab,
+        // so we keep indices into the watch list of lfalse
+        Watcher* ws = watchers.data(lfalse);
+        std::size_t watcher_in = 0;
+        std::size_t watcher_out = 0;
+        std::size_t watcher_end = watchers.size(lfalse);
+        const std::size_t lookahead = m_prefetch_lookahead;
+        const std::size_t half_lookahead = lookahead / 2;
+        if(lookahead && trail_queue_head < trail_lits.size()) {
+            // the watch list of the next literal to be propagated
+            SPROP_PREFETCH(watchers.data(lit::negate(trail_lits[trail_queue_head])));
+        }
 
         // the main loop is essentially a big std::remove_if cleaning
         // up the watchers list 
         // but needs more guarantees than that std::algorithm provides
         while(watcher_in != watcher_end) {
-            if(p_has_true_blocker(watcher_in, watcher_out)) continue;
-            ClauseRef clause = watcher_in->clause;
-            MutClausePtrRange lits = mut_lits_of(clause);
-            Lit* lit_array = lits.begin();
-            Lit* lit_end = lits.end();
-            if(lit_array[0] == lfalse) {
-                // make it so lfalse is in lit_array[1]
-                std::swap(lit_array[0], lit_array[1]);
+            if(lookahead) {
+                if(watcher_in + lookahead < watcher_end)
+                    p_prefetch_watcher(ws[watcher_in + lookahead]);
+                if(half_lookahead && watcher_in + half_lookahead < watcher_end)
+                    p_prefetch_clause(ws[watcher_in + half_lookahead]);
+            }
+            if(p_has_true_blocker(ws, watcher_in, watcher_out)) continue;
+            if constexpr (inline_binary_watchers) {
+                if(ws[watcher_in].is_binary()) {
+                    Lit other = ws[watcher_in].blocker;
+                    ws[watcher_out++] = ws[watcher_in++];
+                    if(!p_propagate_binary(lfalse, other, level)) {
+                        std::copy(ws + watcher_in, ws + watcher_end, ws + watcher_out);
+                        watcher_out += watcher_end - watcher_in;
+                        break;
+                    }
+                    continue;
+                }
             }
+            ClauseRef watched_clause = ws[watcher_in].clause;
+            // make it so lfalse is in watched[1]
+            Lit* watched = p_watched_pair(watched_clause, lfalse);
             // check the other watched literal (if it is not the blocker) as new blocker;
             // also unconditionally advance watcher_in
-            Lit first = lit_array[0];
-            Watcher new_watcher{first, clause};
-            VariableState& first_state = variables[lit::var(first)];
-            if(first != watcher_in++->blocker && first_state.is_true(first)) {
-                *watcher_out++ = new_watcher;
+            Lit first = watched[0];
+            Watcher new_watcher{first, watched_clause};
+            if(first != ws[watcher_in++].blocker && is_true(first)) {
+                ws[watcher_out++] = new_watcher;
                 continue;
             }
-            // search the rest of the clause for an open or true literal
-            Lit* replacement = std::find_if(lit_array + 2, lit_end, [&] (Lit l) { return is_open_or_true(l); });
-            if(replacement != lit_end) {
-                // found replacement; move it to lit_array[1] and install new watcher;
+            bool original = watched_clause < m_learnt_begin;
+            Lit repl = original ? 
+                p_find_original_replacement(watched_clause) :
+                p_find_learnt_replacement(watched);
+            if(repl != NIL) {
+                // found replacement; install new watcher;
                 // do not advance watcher_out
-                Lit repl = *replacement;
-                lit_array[1] = repl;
-                *replacement = lfalse;
-                watchers[repl].push_back(new_watcher);
+                watchers.push_back(repl, new_watcher);
+                ws = watchers.data(lfalse);
             } else {
                 // clause is unit
-                *watcher_out++ = new_watcher;
-                Reason::Clause reason{ClauseLen(lits.size()), clause};
-                if(first_state.is_false(first)) {
+                ws[watcher_out++] = new_watcher;
+                ClauseRef clause = original ? m_original_watches[watched_clause].clause : watched_clause;
+                Reason reason = p_clause_reason(clause);
+                if(is_false(first)) {
                     // conflict
                     conflicting = true;
                     conflict_lit = first;
                     conflict_reason = reason;
-                    watcher_out = std::copy(watcher_in, watcher_end, watcher_out);
+                    std::copy(ws + watcher_in, ws + watcher_end, ws + watcher_out);
+                    watcher_out += watcher_end - watcher_in;
                     break;
                 } else {
-                    p_assign_at(first_state, level, first, reason);
+                    p_assign_at(variables[lit::var(first)], level, first, reason);
                 }
             }
         }
-        ws.erase(watcher_out, watcher_end);
+        watchers.truncate(lfalse, std::uint32_t(watcher_out));
         return !conflicting;
     }
 
     bool p_propagate(Lit ltrue) {
         if (!p_propagate_through_binaries(ltrue))
             return false;
+        if (!p_propagate_through_ternaries(ltrue))
+            return false;
         return p_propagate_through_longer(ltrue);
     }
 
+    /**
+     * Propagation in binary-first mode: before each literal is propagated
+     * through the clauses of length > 2, the binary clauses are propagated
+     * through for all literals on the trail.
+     */
+    bool p_propagate_binary_first() {
+        for (;;) {
+            while (m_binary_queue_head < trail_lits.size()) {
+                if (!p_propagate_through_binaries(trail_lits[m_binary_queue_head++]))
+                    return false;
+            }
+            if (trail_queue_head == trail_lits.size())
+                return true;
+            Lit prop = trail_lits[trail_queue_head++];
+            if (!p_propagate_through_ternaries(prop) || !p_propagate_through_longer(prop))
+                return false;
+        }
+    }
+
+    /**
+     * Get the reason for an assignment forced by the given clause of length > 2
+     * (self-contained for clauses of length 3).
+     */
+    Reason p_clause_reason(ClauseRef clause) const noexcept {
+        ClausePtrRange lits = lits_of(clause);
+        if (lits.size() == 3) {
+            return Reason::Ternary{lits[0], lits[1], lits[2]};
+        }
+        return Reason::Clause{ClauseLen(lits.size()), clause};
+    }
+
     std::uint32_t p_increase_stamp() noexcept {
         if (stamp_counter >= std::numeric_limits<std::uint32_t>::max() - 6) {
             for (VariableState& vs : variables) {
@@ -970,9 +1690,124 @@ class Propagator {
     }
 
     std::uint32_t p_stamp_and_count(std::int32_t level, Reason reason) {
+        if (reason.is_clause_ref()) {
+            p_bump_learnt(reason.clause);
+        }
         return p_stamp_and_count(level, reason.lits(*this));
     }
 
+    /**
+     * Mark the given clause as used in conflict analysis
+     * (if it is a learnt clause).
+     */
+    void p_bump_learnt(ClauseRef clause) noexcept {
+        ClauseHeader header = header_of(clause);
+        if (header.is_learnt()) {
+            header.set_used(true);
+            header.bump_activity();
+            p_set_header(clause, header);
+        }
+    }
+
+    /**
+     * Compute the number of distinct decision levels
+     * of the literals in learn_buffer.
+     */
+    std::uint32_t p_compute_lbd() {
+        auto current = p_increase_stamp();
+        std::uint32_t lbd = 0;
+        for (Lit l : learn_buffer) {
+            LevelInfo& li = levels[variables[lit::var(l)].level()];
+            if (li.get_stamp() != current) {
+                li.stamp_with(current);
+                ++lbd;
+            }
+        }
+        return lbd;
+    }
+
+    /**
+     * Mark all learnt clauses that are currently
+     * the reason for an assignment or the conflict as locked.
+     */
+    void p_lock_reason_clauses() {
+        auto lock = [&] (const Reason& r) {
+            if (!r.is_clause_ref() || r.clause < m_learnt_begin)
+                return;
+            ClauseHeader header = header_of(r.clause);
+            header.set_locked(true);
+            p_set_header(r.clause, header);
+        };
+        std::for_each(trail_reasons.begin(), trail_reasons.end(), lock);
+        if (conflicting)
+            lock(conflict_reason);
+    }
+
+    /**
+     * Remove the learnt clauses marked as garbage from the clause database,
+     * move the remaining learnt clauses to close the gaps,
+     * and update all ClauseRefs in watchers and reasons.
+     */
+    void p_compact_learnts() {
+        std::vector<ClauseRef> old_refs;
+        std::vector<ClauseRef> new_refs;
+        old_refs.reserve(m_num_learnt);
+        new_refs.reserve(m_num_learnt);
+        ClauseRef out = m_learnt_begin;
+        ClauseRef end = longer_clause_end();
+        m_num_learnt = 0;
+        for (ClauseRef in = m_learnt_begin; in != end;) {
+            ClauseHeader header = header_of(in);
+            ClauseRef next = next_clause(in);
+            old_refs.push_back(in);
+            if (header.is_garbage()) {
+                new_refs.push_back(NIL_CLAUSE);
+                in = next;
+                continue;
+            }
+            header.set_used(false);
+            header.set_locked(false);
+            header.decay_activity();
+            p_set_header(in, header);
+            auto db_begin = m_learnt_clause_db.begin();
+            std::copy(db_begin + (in - m_learnt_begin), db_begin + (next - m_learnt_begin), 
+                      db_begin + (out - m_learnt_begin));
+            new_refs.push_back(out);
+            ++m_num_learnt;
+            out += next - in;
+            in = next;
+        }
+        m_learnt_clause_db.resize(out - m_learnt_begin);
+        auto remap = [&] (ClauseRef c) -> ClauseRef {
+            if (c < m_learnt_begin)
+                return c;
+            auto pos = std::lower_bound(old_refs.begin(), old_refs.end(), c);
+            return new_refs[pos - old_refs.begin()];
+        };
+        for (std::size_t l = 0, nl = watchers.num_lists(); l < nl; ++l) {
+            std::uint32_t watcher_out = 0;
+            std::span<Watcher> ws = watchers[l];
+            for (const Watcher& w : ws) {
+                if (w.is_binary()) {
+                    ws[watcher_out++] = w;
+                    continue;
+                }
+                ClauseRef c = remap(w.clause);
+                if (c != NIL_CLAUSE) {
+                    ws[watcher_out++] = Watcher{w.blocker, c};
+                }
+            }
+            watchers.truncate(l, watcher_out);
+        }
+        for (Reason& r : trail_reasons) {
+            if (r.is_clause_ref())
+                r.clause = remap(r.clause);
+        }
+        if (conflict_reason.is_clause_ref()) {
+            conflict_reason.clause = remap(conflict_reason.clause);
+        }
+    }
+
     /**
      * Check if the given literal is redundant in the current conflict clause.
      */
@@ -1034,9 +1869,24 @@ class Propagator {
                            learn_buffer.end());
     }
 
+    /**
+     * Get the highest level of a literal in the conflict clause.
+     * Without chronological backtracking, this is the current level.
+     */
+    std::int32_t p_conflict_level() {
+        std::int32_t level = 0;
+        for (Lit l : conflict_reason.lits(*this)) {
+            level = (std::max)(level, variables[lit::var(l)].level());
+        }
+        return level;
+    }
+
     /**
      * Compute and reduce a conflict clause;
      * it will be stored in learn_buffer.
+     * The conflict must be on the current level; as the trail
+     * may contain lower-level assignments after chronological
+     * backtracking, only literals on that level are resolved.
      */
     void p_compute_conflict_clause() {
         p_increase_stamp();
@@ -1048,7 +1898,7 @@ class Propagator {
         while (on_current_level > 1) {
             Lit l = *trail_lit_iter;
             Lit v = lit::var(l);
-            if (variables[v].get_stamp() >= stamp_counter) {
+            if (variables[v].get_stamp() >= stamp_counter && variables[v].level() == level) {
                 on_current_level +=
                     p_stamp_and_count(level, *trail_reason_iter);
                 --on_current_level;
@@ -1059,7 +1909,7 @@ class Propagator {
         for (;;) {
             Lit l = *trail_lit_iter;
             Lit v = lit::var(l);
-            if (variables[v].get_stamp() >= stamp_counter)
+            if (variables[v].get_stamp() >= stamp_counter && variables[v].level() == level)
                 break;
             --trail_lit_iter;
             --trail_reason_iter;
@@ -1088,17 +1938,16 @@ class Propagator {
     }
 
     /**
-     * Handle jumping back to the target level.
+     * Handle jumping back to the target level, or only one level
+     * down if chronological backtracking applies.
      */
     template <typename AssignmentHandler>
-    std::pair<std::int32_t, Lit> p_jumpback_to_target(AssignmentHandler& handler) 
+    std::pair<std::int32_t, Lit> p_jumpback_to_target(AssignmentHandler& handler, std::size_t& known_end)
     {
         auto [tlvl, tlit] = p_target_level();
-        p_rollback_level(handler, false);
-        while (levels.size() > std::size_t(tlvl + 1)) {
-            p_rollback_level(handler, true);
-        }
-        trail_queue_head = trail_lits.size();
+        std::int32_t clvl = get_current_level();
+        std::int32_t back = std::uint32_t(clvl - tlvl) > m_chrono_max_jump ? clvl - 1 : tlvl;
+        p_rollback_level(handler, back, known_end);
         return {tlvl, tlit};
     }
 
@@ -1106,39 +1955,45 @@ class Propagator {
         switch(learn_buffer.size()) {
             case 1: {
                 m_unary_clauses.push_back(learn_buffer.front());
-                return NIL;
+                return NIL_CLAUSE;
             }
             case 2: {
                 Lit l1 = learn_buffer[0], l2 = learn_buffer[1];
-                m_binary_clauses[l1].push_back(l2);
-                m_binary_clauses[l2].push_back(l1);
-                return NIL;
+                if constexpr (inline_binary_watchers) {
+                    watchers.push_back(l1, Watcher{l2, Watcher::binary_tag});
+                    watchers.push_back(l2, Watcher{l1, Watcher::binary_tag});
+                    return NIL_CLAUSE;
+                }
+                m_binary_clauses.add(l1, l2);
+                if (m_binary_clauses.overflow_size() >= (std::max)(m_binary_clauses.csr_size(), std::size_t(1024))) {
+                    m_binary_clauses.merge_overflow();
+                }
+                return NIL_CLAUSE;
             }
             default: {
-                ClauseRef ref(m_large_clause_db.size() + 1);
-                m_large_clause_db.push_back(ClauseLen(learn_buffer.size()));
-                m_large_clause_db.insert(m_large_clause_db.end(), learn_buffer.begin(), learn_buffer.end());
-                return ref;
+                ++m_num_learnt;
+                ++m_learnts_since_reduction;
+                return p_append_learnt_clause(ClauseHeader::learnt(p_compute_lbd()), learn_buffer);
             }
         }
     }
 
     void p_new_watch(Lit learnt, Lit target_lit, ClauseRef clause) {
-        assert(clause != NIL);
+        assert(clause != NIL_CLAUSE);
         MutClausePtrRange lits = mut_lits_of(clause);
         Lit* lit_array = lits.begin();
         assert(lit_array[0] == learnt);
         auto other = std::find(lits.begin() + 1, lits.end(), target_lit);
         assert(other != lits.end());
         std::swap(lit_array[1], *other);
-        watchers[learnt].push_back(Watcher{target_lit, clause});
-        watchers[target_lit].push_back(Watcher{learnt, clause});
+        watchers.push_back(learnt, Watcher{target_lit, clause});
+        watchers.push_back(target_lit, Watcher{learnt, clause});
     }
 
     template <typename AssignmentHandler>
-    void p_handle_conflict_clause(AssignmentHandler& handler) {
+    void p_handle_conflict_clause(AssignmentHandler& handler, std::size_t& known_end) {
         ClauseRef cref_if_long = p_insert_conflict_clause();
-        auto [tlvl, tlit] = p_jumpback_to_target(handler);
+        auto [tlvl, tlit] = p_jumpback_to_target(handler, known_end);
         Lit learned = learn_buffer.front();
         Lit lv = lit::var(learned);
         std::uint32_t len = learn_buffer.size();
@@ -1149,6 +2004,11 @@ class Propagator {
         case 2:
             p_assign_at(variables[lv], tlvl, learned, Reason::Binary{learned, learn_buffer[1]});
             break;
+        case 3:
+            p_assign_at(variables[lv], tlvl, learned, 
+                        Reason::Ternary{learned, learn_buffer[1], learn_buffer[2]});
+            p_new_watch(learned, tlit, cref_if_long);
+            break;
         default: 
             p_assign_at(variables[lv], tlvl, learned, Reason::Clause{len, cref_if_long});
             p_new_watch(learned, tlit, cref_if_long);
@@ -1156,31 +2016,60 @@ class Propagator {
         }
         learn_buffer.clear();
     }
+
+    /**
+     * Resolve the current conflict and any conflicts following it;
+     * the assignments at trail positions below known_end are known to the handler.
+     */
+    template <typename AssignmentHandler>
+    bool p_resolve_conflicts(AssignmentHandler& assignments, std::size_t known_end);
 };
 
-Propagator::Propagator() :
-    m_num_vars(0),
-    levels{{LevelInfo{0}}}
+template<typename Allocator>
+BasicPropagator<Allocator>::BasicPropagator(const Allocator& alloc) :
+    BasicPropagator(ModelBuilder{}, alloc)
 {}
 
-Propagator::Propagator(const ModelBuilder& model) :
-    m_unary_clauses(model.m_unary_clauses),
-    m_binary_clauses(model.m_binary_clauses),
+template<typename Allocator>
+BasicPropagator<Allocator>::BasicPropagator(const ModelBuilder& model, const Allocator& alloc) :
+    m_original(p_make_original_formula(model, alloc)),
+    m_unary_clauses(model.m_unary_clauses.begin(), model.m_unary_clauses.end(), alloc),
+    m_binary_clauses(alloc),
+    m_learnt_clause_db(alloc),
+    m_original_watches(alloc),
     m_num_vars(model.m_current_lit / 2),
-    variables(m_num_vars),
-    levels{{LevelInfo{0}}}
+    variables(m_num_vars, alloc),
+    m_lit_values(LiteralSearch::padded_size(2 * std::size_t(m_num_vars)), std::int8_t(0), alloc),
+    watchers(alloc),
+    trail_lits(alloc),
+    trail_reasons(alloc),
+    levels({LevelInfo{0}}, alloc),
+    learn_buffer(alloc),
+    supporting_decision_buffer(alloc),
+    m_learnt_begin(ClauseRef(m_original->clause_db.size() + 2))
 {
-    p_process_short_clauses();
-    p_import_large_clauses(model.m_longer_clauses);
+    p_import_binary_clauses(model.m_binary_clauses);
     p_init_watches();
     if(!conflicting) {
         propagate();
     }
 }
 
-bool Propagator::propagate() {
+template<typename Allocator>
+BasicPropagator<Allocator>::BasicPropagator(const BasicPropagator& other, const Allocator& alloc) :
+    BasicPropagator(alloc)
+{
+    // copy assignment keeps our allocator (for allocators that
+    // do not propagate on copy assignment, such as std::pmr)
+    *this = other;
+}
+
+template<typename Allocator>
+bool BasicPropagator<Allocator>::propagate() {
     if (conflicting)
         return false;
+    if (!inline_binary_watchers && m_binary_first)
+        return p_propagate_binary_first();
     while (trail_queue_head < trail_lits.size()) {
         Lit prop = trail_lits[trail_queue_head++];
         if (!p_propagate(prop))
@@ -1189,7 +2078,8 @@ bool Propagator::propagate() {
     return true;
 }
 
-std::vector<Lit> Propagator::get_decisions() const {
+template<typename Allocator>
+std::vector<Lit> BasicPropagator<Allocator>::get_decisions() const {
     std::vector<Lit> result;
     result.reserve(levels.size() - 1);
     for (auto ilvl = levels.begin() + 1, iend = levels.end(); ilvl != iend;
@@ -1200,7 +2090,8 @@ std::vector<Lit> Propagator::get_decisions() const {
     return result;
 }
 
-bool Propagator::resolve_conflicts() {
+template<typename Allocator>
+bool BasicPropagator<Allocator>::resolve_conflicts() {
     struct TrivialAssignmentHandler {
         void assignment_undone(Lit) const noexcept {}
         void assignment_forced(Lit) const noexcept {}
@@ -1209,7 +2100,8 @@ bool Propagator::resolve_conflicts() {
     return resolve_conflicts(handler);
 }
 
-bool Propagator::push_level(Lit decision) {
+template<typename Allocator>
+bool BasicPropagator<Allocator>::push_level(Lit decision) {
     Lit dvar = lit::var(decision);
     VariableState& vstate = variables[dvar];
     if(conflicting) {
@@ -1227,7 +2119,30 @@ bool Propagator::push_level(Lit decision) {
     return propagate();
 }
 
-void Propagator::pop_level() {
+template<typename Allocator>
+std::size_t BasicPropagator<Allocator>::push_assumptions(std::span<const Lit> assumptions) {
+    if(conflicting) {
+        throw std::invalid_argument(
+            "The propagator is already conflicting!");
+    }
+    for (std::size_t i = 0, n = assumptions.size(); i < n; ++i) {
+        Lit assumption = assumptions[i];
+        std::int8_t value = m_lit_values[assumption];
+        if (value > 0)
+            continue;
+        if (value < 0)
+            return i;
+        auto new_level = std::int32_t(levels.size());
+        levels.emplace_back(TrailLen(trail_lits.size()));
+        p_assign_at(variables[lit::var(assumption)], new_level, assumption, Reason::Decision{});
+        if (!propagate())
+            return i;
+    }
+    return assumptions.size();
+}
+
+template<typename Allocator>
+void BasicPropagator<Allocator>::pop_level() {
     if (levels.size() == 1) {
         throw std::invalid_argument(
             "Trying to pop level from propagator at level 0!");
@@ -1235,13 +2150,31 @@ void Propagator::pop_level() {
     struct TrivialHandler {
         void assignment_undone(Lit) {}
     } handler;
-    p_rollback_level(handler, false);
-    trail_queue_head = trail_lits.size();
+    std::size_t known_end = 0;
+    p_rollback_level(handler, get_current_level() - 1, known_end);
     if (conflicting)
         p_reset_conflict();
+    if (trail_queue_head != trail_lits.size())
+        propagate();
 }
 
-const std::vector<std::pair<std::int32_t,Lit>> &Propagator::decisions_leading_to(Lit l) {
+template<typename Allocator>
+void BasicPropagator<Allocator>::reset_to_zero() {
+    if (get_current_level() > 0) {
+        struct TrivialHandler {
+            void assignment_undone(Lit) {}
+        } handler;
+        std::size_t known_end = 0;
+        p_rollback_level(handler, 0, known_end);
+        if (conflicting)
+            p_reset_conflict();
+        if (trail_queue_head != trail_lits.size())
+            propagate();
+    }
+}
+
+template<typename Allocator>
+auto BasicPropagator<Allocator>::decisions_leading_to(Lit l) -> const Vector<std::pair<std::int32_t,Lit>>& {
     if(conflicting) throw std::logic_error("decisions_leading_to called on propagator with conflict!");
     if(is_open(l)) throw std::logic_error("decisions_leading_to called with open literal!");
     supporting_decision_buffer.clear();
@@ -1263,7 +2196,8 @@ const std::vector<std::pair<std::int32_t,Lit>> &Propagator::decisions_leading_to
     return supporting_decision_buffer;
 }
 
-const std::vector<std::pair<std::int32_t,Lit>>& Propagator::decisions_leading_to_conflict() {
+template<typename Allocator>
+auto BasicPropagator<Allocator>::decisions_leading_to_conflict() -> const Vector<std::pair<std::int32_t,Lit>>& {
     if(!conflicting) 
         throw std::logic_error("decisions_leading_to_conflict called on non-conflicting propagator!");
 
@@ -1288,31 +2222,89 @@ const std::vector<std::pair<std::int32_t,Lit>>& Propagator::decisions_leading_to
     return supporting_decision_buffer;
 }
 
+template<typename Allocator>
 template <typename AssignmentHandler>
-bool Propagator::resolve_conflicts(AssignmentHandler& assignments) {
+bool BasicPropagator<Allocator>::resolve_conflicts(AssignmentHandler& assignments) {
     if (!conflicting)
         return true;
-    if (levels.size() == 1)
+    return p_resolve_conflicts(assignments, levels.back().level_begin());
+}
+
+template<typename Allocator>
+template <typename AssignmentHandler>
+bool BasicPropagator<Allocator>::p_resolve_conflicts(AssignmentHandler& assignments, std::size_t known_end) {
+    std::int32_t clvl = p_conflict_level();
+    if (clvl < get_current_level())
+        p_rollback_level(assignments, clvl, known_end);
+    if (clvl == 0)
         return false;
     p_compute_conflict_clause();
-    p_handle_conflict_clause(assignments);
+    p_handle_conflict_clause(assignments, known_end);
     p_reset_conflict();
-    std::size_t tsize = trail_queue_head;
-    std::size_t lbegin = levels.back().level_begin();
     if (!propagate()) {
-        for (std::size_t cpos = tsize - 1; cpos != lbegin - 1; --cpos) {
-            assignments.assignment_undone(trail_lits[cpos]);
-        }
-        return resolve_conflicts(assignments);
+        return p_resolve_conflicts(assignments, known_end);
     } else {
-        for (auto i = trail_lits.begin() + tsize, e = trail_lits.end(); i != e; ++i) {
+        for (auto i = trail_lits.begin() + known_end, e = trail_lits.end(); i != e; ++i) {
             assignments.assignment_forced(*i);
         }
+        if (m_reduction_interval != 0 && m_learnts_since_reduction >= m_reduction_interval) {
+            reduce_learnts();
+        }
         return true;
     }
 }
 
-std::vector<bool> Propagator::extract_assignment() const {
+template<typename Allocator>
+void BasicPropagator<Allocator>::reduce_learnts() {
+    m_learnts_since_reduction = 0;
+    if (m_num_learnt == 0)
+        return;
+    p_lock_reason_clauses();
+    std::vector<ClauseRef> candidates;
+    for (ClauseRef c = m_learnt_begin, e = longer_clause_end(); c != e; c = next_clause(c)) {
+        ClauseHeader header = header_of(c);
+        if (!header.is_locked() && header.lbd() > 2 && clause_length(c) > 3) {
+            candidates.push_back(c);
+        }
+    }
+    auto weaker = [&] (ClauseRef c1, ClauseRef c2) {
+        ClauseHeader h1 = header_of(c1), h2 = header_of(c2);
+        if (h1.is_used() != h2.is_used())
+            return !h1.is_used();
+        if (h1.lbd() != h2.lbd())
+            return h1.lbd() > h2.lbd();
+        return h1.activity() < h2.activity();
+    };
+    auto num_deleted = candidates.size() / 2;
+    std::nth_element(candidates.begin(), candidates.begin() + num_deleted, 
+                     candidates.end(), weaker);
+    for (std::size_t i = 0; i < num_deleted; ++i) {
+        ClauseHeader header = header_of(candidates[i]);
+        header.set_garbage(true);
+        p_set_header(candidates[i], header);
+    }
+    p_compact_learnts();
+}
+
+template<typename Allocator>
+auto BasicPropagator<Allocator>::memory_usage() const noexcept -> MemoryBreakdown {
+    MemoryBreakdown result;
+    result.original_clauses = memory_usage_of(m_original->clause_db) + 
+                              m_original->binary_clauses.memory_usage() +
+                              m_original->ternary_clauses.memory_usage();
+    result.learnt_clauses = memory_usage_of(m_learnt_clause_db);
+    result.watch_lists = watchers.memory_usage() + memory_usage_of(m_original_watches);
+    result.binary_clauses = m_binary_clauses.memory_usage();
+    result.trail = memory_usage_of(trail_lits) + memory_usage_of(trail_reasons) + 
+                   memory_usage_of(levels);
+    result.variables = memory_usage_of(variables) + memory_usage_of(m_lit_values);
+    result.buffers = memory_usage_of(m_unary_clauses) + memory_usage_of(learn_buffer) +
+                     memory_usage_of(supporting_decision_buffer);
+    return result;
+}
+
+template<typename Allocator>
+std::vector<bool> BasicPropagator<Allocator>::extract_assignment() const {
     const Var nv = m_num_vars;
     if(get_trail().size() != nv) {
         throw std::logic_error("Trail incomplete in extract_assignment!");
@@ -1326,6 +2318,21 @@ std::vector<bool> Propagator::extract_assignment() const {
     return result;
 }
 
+/**
+ * @brief A propagator using the default allocator.
+ */
+using Propagator = BasicPropagator<>;
+
+namespace pmr {
+
+/**
+ * @brief A propagator that obtains its memory from a std::pmr::memory_resource.
+ */
+using Propagator = BasicPropagator<std::pmr::polymorphic_allocator<Lit>>;
+
+}
+
+}
 }
 
 #endif
@@ -2,15 +2,20 @@
 #define SP_REASON_H_INCLUDED_
 
 #include "types.h"
+#include <cassert>
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
  * @brief A reason for a propagated literal.
  * Its either a decision (reason_length == 0),
  * a unary clause (reason_length == 1, clause in literals[0]),
  * a binary clause (reason_length == 2, clause in literals),
+ * a clause of length 3 (reason_length == 3, clause in literals),
  * or a longer clause (clause referred to by clause).
+ * Reasons of length <= 3 are self-contained; only longer
+ * clauses require access to the clause database.
  */
 struct Reason {
     /**
@@ -33,7 +38,14 @@ struct Reason {
     };
 
     /**
-     * @brief Type to create a reason from a longer clause.
+     * @brief Type to create a reason from a clause of length 3.
+     */
+    struct Ternary {
+        Lit lit1, lit2, lit3;
+    };
+
+    /**
+     * @brief Type to create a reason from a clause of length > 3.
      */
     struct Clause {
         ClauseLen length;
@@ -51,16 +63,30 @@ struct Reason {
         literals[1] = b.lit2;
     }
 
+    /* implicit */ Reason(Ternary t) noexcept : reason_length(3) {
+        literals[0] = t.lit1;
+        literals[1] = t.lit2;
+        literals[2] = t.lit3;
+    }
+
     /* implicit */ Reason(Clause c) noexcept : reason_length(c.length) {
+        assert(c.length > 3);
         clause = c.clause;
     }
 
     ClauseLen reason_length; //< the length of the reason
     union {
-        ClauseRef clause; //< the clause reference
-        Lit literals[2];  //< the literals of the reason, if length <= 2
+        ClauseRef clause; //< the clause reference, if length > 3
+        Lit literals[3];  //< the literals of the reason, if length <= 3
     };
 
+    /**
+     * @brief Check whether this reason refers to a clause in the clause database.
+     */
+    bool is_clause_ref() const noexcept {
+        return reason_length > 3;
+    }
+
     /**
      * No matter the type of reason, this function returns a range of literals.
      */
@@ -73,12 +99,15 @@ struct Reason {
             return {+literals, literals + 1};
         case 2:
             return {+literals, literals + 2};
+        case 3:
+            return {+literals, literals + 3};
         default:
             return db.lits_of(clause);
         }
     }
 };
 
+}
 }
 
 #endif
@@ -0,0 +1,232 @@
+#ifndef SP_SLAB_LIST_STORE_H_INCLUDED_
+#define SP_SLAB_LIST_STORE_H_INCLUDED_
+
+#include "types.h"
+#include "memory_usage.h"
+#include <vector>
+#include <span>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Storage for many growable lists (e.g., watch lists) in a single slab.
+ * Each non-empty list occupies a block of the slab whose capacity is
+ * given by a size class (min_capacity << size_class). When a list
+ * outgrows its block, it moves to a block of the next size class, which
+ * is taken from the free list of that class or appended to the slab
+ * (the block at the end of the slab is grown in place); the old block is
+ * put on the free list of its class. compact() restores locality by laying
+ * out all lists contiguously in list order.
+ * Growing a list may move the entire slab, invalidating pointers
+ * and spans into all lists.
+ */
+template<typename Entry, typename Allocator = std::allocator<Entry>>
+class SlabListStore {
+    static_assert(std::is_trivially_copyable_v<Entry>, "slab entries must be trivially copyable");
+
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+    static constexpr std::uint32_t no_block = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * The position, size and size class of a list.
+     */
+    struct ListInfo {
+        std::size_t offset{0};
+        std::uint32_t size{0};
+        std::uint32_t size_class{no_block};
+    };
+
+  public:
+    /**
+     * @brief The capacity of the smallest size class.
+     */
+    static constexpr std::uint32_t min_capacity = 4;
+
+    explicit SlabListStore(const Allocator& alloc = Allocator()) :
+        m_slab(alloc), m_lists(alloc), m_free_blocks(alloc)
+    {}
+
+    /**
+     * @brief Get the number of lists.
+     */
+    std::size_t num_lists() const noexcept {
+        return m_lists.size();
+    }
+
+    /**
+     * @brief Change the number of lists; new lists are empty.
+     */
+    void resize(std::size_t num_lists) {
+        for (std::size_t l = num_lists; l < m_lists.size(); ++l) {
+            p_release_block(m_lists[l]);
+        }
+        m_lists.resize(num_lists);
+    }
+
+    /**
+     * @brief Get the size of the given list.
+     */
+    std::uint32_t size(std::size_t list) const noexcept {
+        return m_lists[list].size;
+    }
+
+    /**
+     * @brief Get the capacity of the given list.
+     */
+    std::size_t capacity(std::size_t list) const noexcept {
+        return p_capacity_of(m_lists[list].size_class);
+    }
+
+    /**
+     * @brief Get a pointer to the first entry of the given list.
+     */
+    Entry* data(std::size_t list) noexcept {
+        return m_slab.data() + m_lists[list].offset;
+    }
+
+    const Entry* data(std::size_t list) const noexcept {
+        return m_slab.data() + m_lists[list].offset;
+    }
+
+    std::span<Entry> operator[](std::size_t list) noexcept {
+        return {data(list), size(list)};
+    }
+
+    std::span<const Entry> operator[](std::size_t list) const noexcept {
+        return {data(list), size(list)};
+    }
+
+    /**
+     * @brief Append an entry to the given list.
+     */
+    void push_back(std::size_t list, const Entry& entry) {
+        ListInfo& info = m_lists[list];
+        if (info.size == p_capacity_of(info.size_class)) {
+            p_grow(info);
+        }
+        m_slab[info.offset + info.size++] = entry;
+    }
+
+    /**
+     * @brief Shrink the given list to the given size (keeping its block).
+     */
+    void truncate(std::size_t list, std::uint32_t new_size) noexcept {
+        m_lists[list].size = (std::min)(m_lists[list].size, new_size);
+    }
+
+    /**
+     * @brief Lay out all lists contiguously in list order, each in the
+     *        smallest size class that fits it, and drop all free blocks.
+     */
+    void compact() {
+        std::size_t total = 0;
+        for (const ListInfo& info : m_lists) {
+            total += p_capacity_of(p_size_class_for(info.size));
+        }
+        Vector<Entry> new_slab(m_slab.get_allocator());
+        new_slab.reserve(total);
+        for (ListInfo& info : m_lists) {
+            std::uint32_t new_class = p_size_class_for(info.size);
+            std::size_t new_offset = new_slab.size();
+            const Entry* begin = m_slab.data() + info.offset;
+            new_slab.insert(new_slab.end(), begin, begin + info.size);
+            new_slab.resize(new_offset + p_capacity_of(new_class));
+            info.offset = new_class == no_block ? 0 : new_offset;
+            info.size_class = new_class;
+        }
+        m_slab = std::move(new_slab);
+        m_free_blocks.clear();
+    }
+
+    /**
+     * @brief Get the number of slab entries in blocks on the free lists.
+     */
+    std::size_t free_entries() const noexcept {
+        std::size_t result = 0;
+        for (std::uint32_t c = 0; c < m_free_blocks.size(); ++c) {
+            result += m_free_blocks[c].size() * p_capacity_of(c);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the memory used by the store; only the entries
+     *        in lists count as used, all other slab entries as slack.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        std::size_t used_entries = 0;
+        for (const ListInfo& info : m_lists) {
+            used_entries += info.size;
+        }
+        MemoryUsage result{used_entries * sizeof(Entry), m_slab.capacity() * sizeof(Entry)};
+        return result + memory_usage_of(m_lists) + memory_usage_of(m_free_blocks);
+    }
+
+  private:
+    static std::size_t p_capacity_of(std::uint32_t size_class) noexcept {
+        return size_class == no_block ? 0 : std::size_t(min_capacity) << size_class;
+    }
+
+    static std::uint32_t p_size_class_for(std::size_t size) noexcept {
+        if (size == 0)
+            return no_block;
+        std::uint32_t result = 0;
+        while (p_capacity_of(result) < size)
+            ++result;
+        return result;
+    }
+
+    void p_grow(ListInfo& info) {
+        std::uint32_t new_class = info.size_class == no_block ? 0 : info.size_class + 1;
+        std::size_t old_capacity = p_capacity_of(info.size_class);
+        if (old_capacity != 0 && info.offset + old_capacity == m_slab.size()) {
+            // the block is at the end of the slab: grow in place
+            m_slab.resize(info.offset + p_capacity_of(new_class));
+            info.size_class = new_class;
+            return;
+        }
+        std::size_t new_offset = p_allocate_block(new_class);
+        std::copy_n(m_slab.data() + info.offset, info.size, m_slab.data() + new_offset);
+        p_release_block(info);
+        info.offset = new_offset;
+        info.size_class = new_class;
+    }
+
+    std::size_t p_allocate_block(std::uint32_t size_class) {
+        if (size_class < m_free_blocks.size() && !m_free_blocks[size_class].empty()) {
+            std::size_t result = m_free_blocks[size_class].back();
+            m_free_blocks[size_class].pop_back();
+            return result;
+        }
+        std::size_t result = m_slab.size();
+        m_slab.resize(result + p_capacity_of(size_class));
+        return result;
+    }
+
+    void p_release_block(const ListInfo& info) {
+        if (info.size_class == no_block)
+            return;
+        if (m_free_blocks.size() <= info.size_class) {
+            m_free_blocks.resize(info.size_class + 1);
+        }
+        m_free_blocks[info.size_class].push_back(info.offset);
+    }
+
+    // The slab containing all blocks.
+    Vector<Entry> m_slab;
+    // The position, size and size class of each list.
+    Vector<ListInfo> m_lists;
+    // For each size class, the offsets of the free blocks.
+    Vector<Vector<std::size_t>> m_free_blocks;
+};
+
+}
+}
+
+#endif
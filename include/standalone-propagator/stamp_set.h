@@ -1,6 +1,7 @@
 #ifndef SP_STAMP_SET_H_INCLUDED_
 #define SP_STAMP_SET_H_INCLUDED_
 
+#include "types.h"
 #include <cstdint>
 #include <type_traits>
 #include <limits>
@@ -8,6 +9,7 @@
 #include <concepts>
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
  * @brief A set of integer values implemented using a stamp value.
@@ -85,6 +87,7 @@ class StampSet
     }
 };
 
+}
 }
 
 #endif
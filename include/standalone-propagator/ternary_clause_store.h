@@ -0,0 +1,117 @@
+#ifndef SP_TERNARY_CLAUSE_STORE_H_INCLUDED_
+#define SP_TERNARY_CLAUSE_STORE_H_INCLUDED_
+
+#include "types.h"
+#include "memory_usage.h"
+#include <vector>
+#include <span>
+#include <array>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Occurrence lists of clauses of length 3, indexed by literal.
+ * For each clause (a, b, c), the entry {b, c} is stored for a,
+ * {a, c} for b and {a, b} for c, so that a clause can be propagated
+ * when one of its literals becomes false without accessing it.
+ * All entries are stored in a single compressed sparse row (CSR) block:
+ * the entries of literal l are m_entries[m_offsets[l]] to m_entries[m_offsets[l+1]].
+ * The store is built once and immutable afterwards.
+ * All memory is obtained from the given allocator (rebound as necessary).
+ */
+template<typename Allocator = std::allocator<Lit>>
+class BasicTernaryClauseStore {
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  public:
+    /**
+     * @brief The two other literals of a clause, stored for its third literal.
+     */
+    using Entry = std::array<Lit, 2>;
+
+    explicit BasicTernaryClauseStore(const Allocator& alloc = Allocator()) :
+        m_offsets(1, 0, alloc), m_entries(alloc)
+    {}
+
+    /**
+     * @brief Build the occurrence lists for the literals 0, ..., num_lits - 1
+     *        from the given range of clauses; clauses with a length other than 3 are ignored.
+     */
+    template<typename ClauseRange>
+    void build(const ClauseRange& clauses, Lit num_lits) {
+        m_offsets.assign(num_lits + 1, 0);
+        std::size_t total = 0;
+        for (const auto& clause : clauses) {
+            if (std::ranges::size(clause) != 3)
+                continue;
+            for (Lit l : clause) {
+                ++m_offsets[l + 1];
+            }
+            total += 3;
+        }
+        if (total > std::numeric_limits<ClauseRef>::max()) {
+            throw std::length_error("Too many ternary clauses for the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
+        }
+        for (Lit l = 0; l < num_lits; ++l) {
+            m_offsets[l + 1] += m_offsets[l];
+        }
+        m_entries.resize(total);
+        // fill using a running insert position per literal, then restore the offsets
+        for (const auto& clause : clauses) {
+            if (std::ranges::size(clause) != 3)
+                continue;
+            auto i = std::ranges::begin(clause);
+            Lit a = i[0], b = i[1], c = i[2];
+            m_entries[m_offsets[a]++] = Entry{b, c};
+            m_entries[m_offsets[b]++] = Entry{a, c};
+            m_entries[m_offsets[c]++] = Entry{a, b};
+        }
+        for (Lit l = num_lits; l > 0; --l) {
+            m_offsets[l] = m_offsets[l - 1];
+        }
+        m_offsets[0] = 0;
+    }
+
+    /**
+     * @brief Get the entries of the clauses containing the given literal.
+     */
+    std::span<const Entry> occurrences_of(Lit l) const noexcept {
+        const Entry* data = m_entries.data();
+        return {data + m_offsets[l], data + m_offsets[l + 1]};
+    }
+
+    /**
+     * @brief Get the number of entries (three per clause).
+     */
+    std::size_t size() const noexcept {
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Get the memory used by the store.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return memory_usage_of(m_offsets) + memory_usage_of(m_entries);
+    }
+
+  private:
+    // CSR offsets (one per literal, plus one).
+    Vector<ClauseRef> m_offsets;
+    // CSR entry block.
+    Vector<Entry> m_entries;
+};
+
+/**
+ * @brief Ternary clause storage using the default allocator.
+ */
+using TernaryClauseStore = BasicTernaryClauseStore<>;
+
+}
+}
+
+#endif
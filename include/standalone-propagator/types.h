@@ -8,22 +8,106 @@
 #include <ranges>
 #include <concepts>
 #include <utility>
+#include <type_traits>
+
+/**
+ * The widths (in bits; 32 or 64) of literals, clause references and
+ * trail lengths used by all components. For instance, define
+ * SPROP_CLAUSE_REF_BITS to 64 for clause arenas with more than 4G words.
+ * All components are declared in an inline namespace named after these
+ * widths (SPROP_INDEX_NAMESPACE), so that translation units configured
+ * with different widths never share definitions; mixing them
+ * in one interface fails to compile or link instead.
+ */
+#ifndef SPROP_LIT_BITS
+#define SPROP_LIT_BITS 32
+#endif
+
+#ifndef SPROP_CLAUSE_REF_BITS
+#define SPROP_CLAUSE_REF_BITS 32
+#endif
+
+#ifndef SPROP_TRAIL_LEN_BITS
+#define SPROP_TRAIL_LEN_BITS 32
+#endif
+
+#ifdef SPROP_INDEX_TRAITS
+#error "SPROP_INDEX_TRAITS is no longer supported; define SPROP_LIT_BITS, SPROP_CLAUSE_REF_BITS or SPROP_TRAIL_LEN_BITS instead."
+#endif
+
+#define SPROP_INDEX_NAMESPACE_NAME_(l, c, t) index_l##l##_c##c##_t##t
+#define SPROP_INDEX_NAMESPACE_NAME(l, c, t) SPROP_INDEX_NAMESPACE_NAME_(l, c, t)
+#define SPROP_INDEX_NAMESPACE \
+    SPROP_INDEX_NAMESPACE_NAME(SPROP_LIT_BITS, SPROP_CLAUSE_REF_BITS, SPROP_TRAIL_LEN_BITS)
 
 namespace sprop {
 
+/**
+ * @brief The unsigned integer type with the given number of bits (32 or 64).
+ */
+template<unsigned Bits> requires (Bits == 32 || Bits == 64)
+using UnsignedOfBits = std::conditional_t<Bits == 32, std::uint32_t, std::uint64_t>;
+
+/**
+ * @brief Index traits with the given widths of literals,
+ *        clause references and trail lengths.
+ */
+template<unsigned LitBits, unsigned ClauseRefBits, unsigned TrailLenBits>
+struct FixedWidthIndexTraits {
+    using lit_type = UnsignedOfBits<LitBits>;
+    using clause_ref_type = UnsignedOfBits<ClauseRefBits>;
+    using trail_len_type = UnsignedOfBits<TrailLenBits>;
+};
+
+/**
+ * @brief The default index widths: 32-bit literals,
+ *        clause references and trail lengths.
+ */
+using DefaultIndexTraits = FixedWidthIndexTraits<32, 32, 32>;
+
+/**
+ * @brief Index widths with 64-bit clause references, for clause arenas
+ *        (original and learnt clauses) with more than 4G words.
+ */
+using WideClauseRefIndexTraits = FixedWidthIndexTraits<32, 64, 32>;
+
+/**
+ * @brief Requirements on index traits.
+ * Literals need at least 32 bits, as clause headers are stored
+ * in literal-sized words; clause references and trail lengths 
+ * must be able to hold all literals.
+ */
+template<typename T>
+concept IndexTraitsType = 
+    std::unsigned_integral<typename T::lit_type> &&
+    std::unsigned_integral<typename T::clause_ref_type> &&
+    std::unsigned_integral<typename T::trail_len_type> &&
+    sizeof(typename T::lit_type) >= 4 &&
+    sizeof(typename T::clause_ref_type) >= sizeof(typename T::lit_type) &&
+    sizeof(typename T::trail_len_type) >= sizeof(typename T::lit_type);
+
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * The index traits used by all components (see SPROP_LIT_BITS).
+ */
+using IndexTraits = FixedWidthIndexTraits<SPROP_LIT_BITS, SPROP_CLAUSE_REF_BITS, SPROP_TRAIL_LEN_BITS>;
+
+static_assert(IndexTraitsType<IndexTraits>, "invalid index widths");
+
 /**
  * A literal in the internal sense:
  *  - Even numbers are positive literals,
  *  - Odd numbers are negative literals.
  *  - For variables x, we thus have 2 * x and 2 * x + 1 as literals.
  */
-using Lit = std::uint32_t;
+using Lit = IndexTraits::lit_type;
 
 /**
  * The length of a trail, i.e., the number of literals on the trail.
  * This has to be large enough to accommodate the number of variables + 1.
  */
-using TrailLen = std::uint32_t;
+using TrailLen = IndexTraits::trail_len_type;
 
 /**
  * An integer that is used to refer to variables.
@@ -34,10 +118,11 @@ using Var = Lit;
  * A reference to a clause, i.e., a clause begin index,
  * can be used to uniquely identify a clause in a clause database.
  */
-using ClauseRef = Lit;
+using ClauseRef = IndexTraits::clause_ref_type;
 
 /**
  * A clause length number type, used to store the length of clauses.
+ * Lengths are stored in literal-sized words in the clause arena.
  */
 using ClauseLen = Lit;
 
@@ -58,6 +143,12 @@ using MutClausePtrRange = std::remove_cvref_t<
  */
 static constexpr Lit NIL = std::numeric_limits<Lit>::max();
 
+/**
+ * A value that indicates an invalid clause reference.
+ */
+static constexpr ClauseRef NIL_CLAUSE = std::numeric_limits<ClauseRef>::max();
+
+}
 }
 
 #endif
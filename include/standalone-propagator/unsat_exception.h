@@ -1,10 +1,12 @@
 #ifndef SP_UNSAT_EXCEPTION_H_INCLUDED_
 #define SP_UNSAT_EXCEPTION_H_INCLUDED_
 
+#include "types.h"
 #include <stdexcept>
 #include <exception>
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 class UNSATException : public std::exception {
     public:
@@ -15,6 +17,7 @@ class UNSATException : public std::exception {
         }
 };
 
+}
 }
 
 #endif
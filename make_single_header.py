@@ -19,6 +19,25 @@ def collect_headers(header_dirs: list[Path]) -> dict[str, Path]:
 _include_line_re = re.compile(r'^\s*[#]\s*include\s*([<"])([^>"]+)([>"])\s*$')
 
 
+def conditional_system_include_lines(lines: list[str]) -> set[int]:
+    """
+    Find the indices of lines with system includes that are nested
+    in a preprocessor conditional (other than the include guard);
+    these are kept in place instead of being moved to the top.
+    """
+    result = set()
+    depth = 0
+    for index, line_ in enumerate(lines):
+        line = line_.strip()
+        if line.startswith('#if'):
+            depth += 1
+        elif line.startswith('#endif'):
+            depth -= 1
+        elif line.startswith('#include') and depth > 1 and '<' in line:
+            result.add(index)
+    return result
+
+
 def handle_header_line(headers: dict[str, Path], header_includes: set[str], header_stdincludes: set[str], line: str):
     m = _include_line_re.match(line)
     if not m or m.group(1) != m.group(3).replace(">", "<"):
@@ -41,9 +60,10 @@ def collect_includes(headers: dict[str, Path]) -> tuple[dict[str, list[str]], di
         this_stdincludes = set()
         with open(headers[header], 'r') as f:
             lines = f.readlines()
-            for line_ in lines:
+            keep = conditional_system_include_lines(lines)
+            for index, line_ in enumerate(lines):
                 line = line_.strip()
-                if line.startswith('#include'):
+                if line.startswith('#include') and index not in keep:
                     handle_header_line(headers, this_includes, this_stdincludes, line)
         header_includes[header] = list(this_includes)
         stdincludes[header] = list(this_stdincludes)
@@ -72,8 +92,9 @@ def write_output_header(all_headers: dict[str, Path], header_order: list[str],
             path = all_headers[header]
             with path.open('r') as header_file:
                 lines = header_file.readlines()
-                for line in lines:
-                    if line.strip().startswith('#include'):
+                keep = conditional_system_include_lines(lines)
+                for index, line in enumerate(lines):
+                    if line.strip().startswith('#include') and index not in keep:
                         continue
                     f.write(line)
             f.write(f"/// End original header: '{header}'\n\n")
@@ -4,23 +4,32 @@
 /// DO NOT EDIT THIS AUTO-GENERATED FILE
 
 /// Standard library includes
-#include <format>
-#include <sstream>
-#include <cassert>
-#include <ranges>
-#include <concepts>
-#include <type_traits>
-#include <algorithm>
-#include <stdexcept>
-#include <vector>
-#include <optional>
-#include <cstddef>
 #include <exception>
-#include <utility>
+#include <algorithm>
+#include <memory_resource>
 #include <cmath>
-#include <limits>
+#include <cassert>
+#include <utility>
 #include <cstdint>
+#include <cstring>
+#include <span>
+#include <array>
+#include <functional>
+#include <climits>
+#include <type_traits>
 #include <string>
+#include <format>
+#include <concepts>
+#include <sstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <limits>
+#include <ranges>
+#include <new>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
 
 /// Project headers concatenated into a single header
 /// Original header: #include "types.h"
@@ -28,21 +37,104 @@
 #define SP_TYPES_H_INCLUDED_
 
 
+/**
+ * The widths (in bits; 32 or 64) of literals, clause references and
+ * trail lengths used by all components. For instance, define
+ * SPROP_CLAUSE_REF_BITS to 64 for clause arenas with more than 4G words.
+ * All components are declared in an inline namespace named after these
+ * widths (SPROP_INDEX_NAMESPACE), so that translation units configured
+ * with different widths never share definitions; mixing them
+ * in one interface fails to compile or link instead.
+ */
+#ifndef SPROP_LIT_BITS
+#define SPROP_LIT_BITS 32
+#endif
+
+#ifndef SPROP_CLAUSE_REF_BITS
+#define SPROP_CLAUSE_REF_BITS 32
+#endif
+
+#ifndef SPROP_TRAIL_LEN_BITS
+#define SPROP_TRAIL_LEN_BITS 32
+#endif
+
+#ifdef SPROP_INDEX_TRAITS
+#error "SPROP_INDEX_TRAITS is no longer supported; define SPROP_LIT_BITS, SPROP_CLAUSE_REF_BITS or SPROP_TRAIL_LEN_BITS instead."
+#endif
+
+#define SPROP_INDEX_NAMESPACE_NAME_(l, c, t) index_l##l##_c##c##_t##t
+#define SPROP_INDEX_NAMESPACE_NAME(l, c, t) SPROP_INDEX_NAMESPACE_NAME_(l, c, t)
+#define SPROP_INDEX_NAMESPACE \
+    SPROP_INDEX_NAMESPACE_NAME(SPROP_LIT_BITS, SPROP_CLAUSE_REF_BITS, SPROP_TRAIL_LEN_BITS)
+
 namespace sprop {
 
+/**
+ * @brief The unsigned integer type with the given number of bits (32 or 64).
+ */
+template<unsigned Bits> requires (Bits == 32 || Bits == 64)
+using UnsignedOfBits = std::conditional_t<Bits == 32, std::uint32_t, std::uint64_t>;
+
+/**
+ * @brief Index traits with the given widths of literals,
+ *        clause references and trail lengths.
+ */
+template<unsigned LitBits, unsigned ClauseRefBits, unsigned TrailLenBits>
+struct FixedWidthIndexTraits {
+    using lit_type = UnsignedOfBits<LitBits>;
+    using clause_ref_type = UnsignedOfBits<ClauseRefBits>;
+    using trail_len_type = UnsignedOfBits<TrailLenBits>;
+};
+
+/**
+ * @brief The default index widths: 32-bit literals,
+ *        clause references and trail lengths.
+ */
+using DefaultIndexTraits = FixedWidthIndexTraits<32, 32, 32>;
+
+/**
+ * @brief Index widths with 64-bit clause references, for clause arenas
+ *        (original and learnt clauses) with more than 4G words.
+ */
+using WideClauseRefIndexTraits = FixedWidthIndexTraits<32, 64, 32>;
+
+/**
+ * @brief Requirements on index traits.
+ * Literals need at least 32 bits, as clause headers are stored
+ * in literal-sized words; clause references and trail lengths 
+ * must be able to hold all literals.
+ */
+template<typename T>
+concept IndexTraitsType = 
+    std::unsigned_integral<typename T::lit_type> &&
+    std::unsigned_integral<typename T::clause_ref_type> &&
+    std::unsigned_integral<typename T::trail_len_type> &&
+    sizeof(typename T::lit_type) >= 4 &&
+    sizeof(typename T::clause_ref_type) >= sizeof(typename T::lit_type) &&
+    sizeof(typename T::trail_len_type) >= sizeof(typename T::lit_type);
+
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * The index traits used by all components (see SPROP_LIT_BITS).
+ */
+using IndexTraits = FixedWidthIndexTraits<SPROP_LIT_BITS, SPROP_CLAUSE_REF_BITS, SPROP_TRAIL_LEN_BITS>;
+
+static_assert(IndexTraitsType<IndexTraits>, "invalid index widths");
+
 /**
  * A literal in the internal sense:
  *  - Even numbers are positive literals,
  *  - Odd numbers are negative literals.
  *  - For variables x, we thus have 2 * x and 2 * x + 1 as literals.
  */
-using Lit = std::uint32_t;
+using Lit = IndexTraits::lit_type;
 
 /**
  * The length of a trail, i.e., the number of literals on the trail.
  * This has to be large enough to accommodate the number of variables + 1.
  */
-using TrailLen = std::uint32_t;
+using TrailLen = IndexTraits::trail_len_type;
 
 /**
  * An integer that is used to refer to variables.
@@ -53,10 +145,11 @@ using Var = Lit;
  * A reference to a clause, i.e., a clause begin index,
  * can be used to uniquely identify a clause in a clause database.
  */
-using ClauseRef = Lit;
+using ClauseRef = IndexTraits::clause_ref_type;
 
 /**
  * A clause length number type, used to store the length of clauses.
+ * Lengths are stored in literal-sized words in the clause arena.
  */
 using ClauseLen = Lit;
 
@@ -77,96 +170,210 @@ using MutClausePtrRange = std::remove_cvref_t<
  */
 static constexpr Lit NIL = std::numeric_limits<Lit>::max();
 
+/**
+ * A value that indicates an invalid clause reference.
+ */
+static constexpr ClauseRef NIL_CLAUSE = std::numeric_limits<ClauseRef>::max();
+
+}
 }
 
 #endif
 /// End original header: 'types.h'
 
-/// Original header: #include "reason.h"
-#ifndef SP_REASON_H_INCLUDED_
-#define SP_REASON_H_INCLUDED_
+/// Original header: #include "literal_search.h"
+#ifndef SP_LITERAL_SEARCH_H_INCLUDED_
+#define SP_LITERAL_SEARCH_H_INCLUDED_
+
+
+/**
+ * If defined to 1, searches for non-false literals in long clauses
+ * use AVX2/AVX-512 gather kernels when the CPU supports them
+ * (selected at runtime); requires x86 and GCC or Clang.
+ * Defaults to 0: on the benchmark workloads, replacements are
+ * usually found among the first few literals, and the kernels
+ * did not yield a measurable end-to-end gain.
+ */
+#ifndef SPROP_SIMD_LITERAL_SEARCH
+#define SPROP_SIMD_LITERAL_SEARCH 0
+#endif
+
+/**
+ * If defined to 1 (and SIMD literal search is enabled), the AVX-512 kernel
+ * is preferred over the AVX2 kernel on CPUs that support both.
+ * Defaults to 0: replacements are usually found within the first few
+ * literals checked, where the wider gather mostly adds latency.
+ */
+#ifndef SPROP_SIMD_LITERAL_SEARCH_AVX512
+#define SPROP_SIMD_LITERAL_SEARCH_AVX512 0
+#endif
 
+#if SPROP_SIMD_LITERAL_SEARCH
+#include <immintrin.h>
+#endif
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
- * @brief A reason for a propagated literal.
- * Its either a decision (reason_length == 0),
- * a unary clause (reason_length == 1, clause in literals[0]),
- * a binary clause (reason_length == 2, clause in literals),
- * or a longer clause (clause referred to by clause).
+ * @brief Searches for literals that are not false in ranges of
+ *        literals, given a per-literal value array (1 true, 0 open, -1 false).
+ * The value array must be padded to a multiple of 4 entries,
+ * as the vectorized kernels read the aligned 4-byte group of each value.
  */
-struct Reason {
+class LiteralSearch {
+  public:
+    using KernelFunction = const Lit* (*)(const Lit*, const Lit*, const std::int8_t*) noexcept;
+
     /**
-     * @brief Type to create a reason from a decision.
+     * @brief Ranges with at least this many literals are
+     *        searched by the vectorized kernel (if available).
      */
-    struct Decision {};
+    static constexpr std::size_t simd_threshold = 16;
 
     /**
-     * @brief Type to create a reason from a unary clause.
+     * @brief The number of literals at the beginning of long ranges that
+     *        are checked one by one, as replacements are often found early.
      */
-    struct Unary {
-        Lit lit;
-    };
+    static constexpr std::size_t scalar_prefix = 8;
 
     /**
-     * @brief Type to create a reason from a binary clause.
+     * @brief Get the number of value array entries needed for the given number of literals.
      */
-    struct Binary {
-        Lit lit1, lit2;
-    };
+    static constexpr std::size_t padded_size(std::size_t num_lits) noexcept {
+        return (num_lits + 3) & ~std::size_t(3);
+    }
 
     /**
-     * @brief Type to create a reason from a longer clause.
+     * @brief Find the first literal in [begin, end) that is not false;
+     *        return end if there is none.
      */
-    struct Clause {
-        ClauseLen length;
-        ClauseRef clause;
-    };
-
-    /* implicit */ Reason(Decision) noexcept : reason_length(0) {}
+    static const Lit* find_non_false(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+#if SPROP_SIMD_LITERAL_SEARCH
+        if (std::size_t(end - begin) >= simd_threshold) {
+            const Lit* prefix_end = begin + scalar_prefix;
+            const Lit* result = find_non_false_scalar(begin, prefix_end, values);
+            return result != prefix_end ? result : p_kernel()(prefix_end, end, values);
+        }
+#endif
+        return find_non_false_scalar(begin, end, values);
+    }
 
-    /* implicit */ Reason(Unary unary) noexcept : reason_length(1) {
-        literals[0] = unary.lit;
+    static Lit* find_non_false(Lit* begin, Lit* end, const std::int8_t* values) noexcept {
+        return const_cast<Lit*>(find_non_false(static_cast<const Lit*>(begin),
+                                               static_cast<const Lit*>(end), values));
     }
 
-    /* implicit */ Reason(Binary b) noexcept : reason_length(2) {
-        literals[0] = b.lit1;
-        literals[1] = b.lit2;
+    /**
+     * @brief The scalar search; also handles the tails of the vectorized kernels.
+     */
+    static const Lit* find_non_false_scalar(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+        for (; begin != end; ++begin) {
+            if (values[*begin] >= 0)
+                return begin;
+        }
+        return end;
     }
 
-    /* implicit */ Reason(Clause c) noexcept : reason_length(c.length) {
-        clause = c.clause;
+    /**
+     * @brief The name of the kernel selected for this CPU ("avx512", "avx2" or "scalar").
+     */
+    static const char* kernel_name() noexcept {
+#if SPROP_SIMD_LITERAL_SEARCH
+        if constexpr (sizeof(Lit) == 4) {
+#if SPROP_SIMD_LITERAL_SEARCH_AVX512
+            if (p_kernel() == &p_find_non_false_avx512)
+                return "avx512";
+#endif
+            if (p_kernel() == &p_find_non_false_avx2)
+                return "avx2";
+        }
+#endif
+        return "scalar";
     }
 
-    ClauseLen reason_length; //< the length of the reason
-    union {
-        ClauseRef clause; //< the clause reference
-        Lit literals[2];  //< the literals of the reason, if length <= 2
-    };
+  private:
+#if SPROP_SIMD_LITERAL_SEARCH
+    /**
+     * Check 8 literals at a time: gather the aligned 4-byte group
+     * containing each value (indices lit / 4 are non-negative even for
+     * literals >= 2^31), shift the value into the top byte and
+     * collect the sign bits, which mark false literals.
+     */
+    __attribute__((target("avx2")))
+    static const Lit* p_find_non_false_avx2(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+        const __m256i three = _mm256_set1_epi32(3);
+        for (; end - begin >= 8; begin += 8) {
+            __m256i lits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            __m256i groups = _mm256_i32gather_epi32(reinterpret_cast<const int*>(values),
+                                                    _mm256_srli_epi32(lits, 2), 4);
+            __m256i shift = _mm256_slli_epi32(_mm256_andnot_si256(lits, three), 3);
+            __m256i top = _mm256_sllv_epi32(groups, shift);
+            unsigned non_false = ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(top))) & 0xffu;
+            if (non_false) {
+                return begin + __builtin_ctz(non_false);
+            }
+        }
+        return find_non_false_scalar(begin, end, values);
+    }
 
+#if SPROP_SIMD_LITERAL_SEARCH_AVX512
     /**
-     * No matter the type of reason, this function returns a range of literals.
+     * Like the AVX2 kernel, but checking 16 literals at a time.
+     * Uses the zero-masking forms of the intrinsics with a full mask;
+     * the unmasked forms pass an undefined source that GCC warns about.
      */
-    template<typename ClauseContainer>
-    ClausePtrRange lits(const ClauseContainer& db) const noexcept {
-        switch (reason_length) {
-        case 0:
-            return {nullptr, nullptr};
-        case 1:
-            return {+literals, literals + 1};
-        case 2:
-            return {+literals, literals + 2};
-        default:
-            return db.lits_of(clause);
+    __attribute__((target("avx512f")))
+    static const Lit* p_find_non_false_avx512(const Lit* begin, const Lit* end, const std::int8_t* values) noexcept {
+        const __mmask16 all = 0xffff;
+        const __m512i three = _mm512_set1_epi32(3);
+        const __m512i zero = _mm512_setzero_si512();
+        for (; end - begin >= 16; begin += 16) {
+            __m512i lits = _mm512_loadu_si512(begin);
+            __m512i indices = _mm512_maskz_srli_epi32(all, lits, 2);
+            __m512i groups = _mm512_mask_i32gather_epi32(zero, all, indices, values, 4);
+            __m512i shift = _mm512_maskz_slli_epi32(all, _mm512_maskz_andnot_epi32(all, lits, three), 3);
+            __m512i top = _mm512_maskz_sllv_epi32(all, groups, shift);
+            unsigned non_false = _mm512_cmpge_epi32_mask(top, zero);
+            if (non_false) {
+                return begin + __builtin_ctz(non_false);
+            }
+        }
+        return find_non_false_scalar(begin, end, values);
+    }
+#endif
+#endif
+
+    static KernelFunction p_select_kernel() noexcept {
+#if SPROP_SIMD_LITERAL_SEARCH
+        if constexpr (sizeof(Lit) == 4) {
+            __builtin_cpu_init();
+#if SPROP_SIMD_LITERAL_SEARCH_AVX512
+            if (__builtin_cpu_supports("avx512f"))
+                return &p_find_non_false_avx512;
+#endif
+            if (__builtin_cpu_supports("avx2"))
+                return &p_find_non_false_avx2;
         }
+#endif
+        return &find_non_false_scalar;
+    }
+
+    /**
+     * The kernel for long ranges, selected once for the running CPU
+     * (on first use, so that it is also available during static initialization).
+     */
+    static KernelFunction p_kernel() noexcept {
+        static const KernelFunction kernel = p_select_kernel();
+        return kernel;
     }
 };
 
+}
 }
 
 #endif
-/// End original header: 'reason.h'
+/// End original header: 'literal_search.h'
 
 /// Original header: #include "unsat_exception.h"
 #ifndef SP_UNSAT_EXCEPTION_H_INCLUDED_
@@ -174,6 +381,7 @@ struct Reason {
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 class UNSATException : public std::exception {
     public:
@@ -184,6 +392,7 @@ class UNSATException : public std::exception {
         }
 };
 
+}
 }
 
 #endif
@@ -195,6 +404,7 @@ class UNSATException : public std::exception {
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
  * @brief A set of integer values implemented using a stamp value.
@@ -272,17 +482,89 @@ class StampSet
     }
 };
 
+}
 }
 
 #endif
 /// End original header: 'stamp_set.h'
 
+/// Original header: #include "memory_usage.h"
+#ifndef SP_MEMORY_USAGE_H_INCLUDED_
+#define SP_MEMORY_USAGE_H_INCLUDED_
+
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief The dynamic memory used by a data structure, in bytes.
+ * Used bytes are occupied by elements; reserved bytes are all
+ * bytes currently allocated (i.e., used bytes plus capacity slack).
+ */
+struct MemoryUsage {
+    std::size_t used{0};
+    std::size_t reserved{0};
+
+    /**
+     * @brief The number of bytes that are allocated but not used.
+     */
+    std::size_t slack() const noexcept { return reserved - used; }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) noexcept {
+        used += other.used;
+        reserved += other.reserved;
+        return *this;
+    }
+
+    friend MemoryUsage operator+(MemoryUsage a, const MemoryUsage& b) noexcept {
+        return a += b;
+    }
+};
+
+/**
+ * @brief Get the memory used by the elements of a vector.
+ */
+template<typename T, typename Allocator>
+MemoryUsage memory_usage_of(const std::vector<T, Allocator>& v) noexcept {
+    return MemoryUsage{v.size() * sizeof(T), v.capacity() * sizeof(T)};
+}
+
+/**
+ * @brief Get the memory used by a bit vector.
+ */
+template<typename Allocator>
+MemoryUsage memory_usage_of(const std::vector<bool, Allocator>& v) noexcept {
+    return MemoryUsage{(v.size() + CHAR_BIT - 1) / CHAR_BIT,
+                       (v.capacity() + CHAR_BIT - 1) / CHAR_BIT};
+}
+
+/**
+ * @brief Get the memory used by a vector of vectors,
+ *        including the memory of the inner vectors.
+ */
+template<typename T, typename InnerAllocator, typename Allocator>
+MemoryUsage memory_usage_of(const std::vector<std::vector<T, InnerAllocator>, Allocator>& v) noexcept {
+    using Inner = std::vector<T, InnerAllocator>;
+    MemoryUsage result{v.size() * sizeof(Inner), v.capacity() * sizeof(Inner)};
+    for (const Inner& inner : v) {
+        result += memory_usage_of(inner);
+    }
+    return result;
+}
+
+}
+}
+
+#endif
+/// End original header: 'memory_usage.h'
+
 /// Original header: #include "literal_ops.h"
 #ifndef SP_LITERAL_OPS_H_INCLUDED_
 #define SP_LITERAL_OPS_H_INCLUDED_
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 namespace lit {
 
 /**
@@ -348,137 +630,1251 @@ static inline constexpr Lit absolute(Lit l) noexcept {
     return l & ~Lit(1);
 }
 
-/**
- * @brief Check if a literal is true in a given assignment.
- */
-template<typename BitsetType>
-static inline bool is_true_in(Lit l, const BitsetType& assignment) noexcept
-{
-    bool value(assignment[var(l)]);
-    return negative(l) ? !value : value;
-}
+/**
+ * @brief Check if a literal is true in a given assignment.
+ */
+template<typename BitsetType>
+static inline bool is_true_in(Lit l, const BitsetType& assignment) noexcept
+{
+    bool value(assignment[var(l)]);
+    return negative(l) ? !value : value;
+}
+
+/**
+ * @brief Check if a literal is false in a given assignment.
+ */
+template<typename BitsetType>
+static inline bool is_false_in(Lit l, const BitsetType& assignment) noexcept
+{
+    return !is_true_in(l, assignment);
+}
+
+}
+}
+}
+
+#endif
+/// End original header: 'literal_ops.h'
+
+/// Original header: #include "ternary_clause_store.h"
+#ifndef SP_TERNARY_CLAUSE_STORE_H_INCLUDED_
+#define SP_TERNARY_CLAUSE_STORE_H_INCLUDED_
+
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Occurrence lists of clauses of length 3, indexed by literal.
+ * For each clause (a, b, c), the entry {b, c} is stored for a,
+ * {a, c} for b and {a, b} for c, so that a clause can be propagated
+ * when one of its literals becomes false without accessing it.
+ * All entries are stored in a single compressed sparse row (CSR) block:
+ * the entries of literal l are m_entries[m_offsets[l]] to m_entries[m_offsets[l+1]].
+ * The store is built once and immutable afterwards.
+ * All memory is obtained from the given allocator (rebound as necessary).
+ */
+template<typename Allocator = std::allocator<Lit>>
+class BasicTernaryClauseStore {
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  public:
+    /**
+     * @brief The two other literals of a clause, stored for its third literal.
+     */
+    using Entry = std::array<Lit, 2>;
+
+    explicit BasicTernaryClauseStore(const Allocator& alloc = Allocator()) :
+        m_offsets(1, 0, alloc), m_entries(alloc)
+    {}
+
+    /**
+     * @brief Build the occurrence lists for the literals 0, ..., num_lits - 1
+     *        from the given range of clauses; clauses with a length other than 3 are ignored.
+     */
+    template<typename ClauseRange>
+    void build(const ClauseRange& clauses, Lit num_lits) {
+        m_offsets.assign(num_lits + 1, 0);
+        std::size_t total = 0;
+        for (const auto& clause : clauses) {
+            if (std::ranges::size(clause) != 3)
+                continue;
+            for (Lit l : clause) {
+                ++m_offsets[l + 1];
+            }
+            total += 3;
+        }
+        if (total > std::numeric_limits<ClauseRef>::max()) {
+            throw std::length_error("Too many ternary clauses for the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
+        }
+        for (Lit l = 0; l < num_lits; ++l) {
+            m_offsets[l + 1] += m_offsets[l];
+        }
+        m_entries.resize(total);
+        // fill using a running insert position per literal, then restore the offsets
+        for (const auto& clause : clauses) {
+            if (std::ranges::size(clause) != 3)
+                continue;
+            auto i = std::ranges::begin(clause);
+            Lit a = i[0], b = i[1], c = i[2];
+            m_entries[m_offsets[a]++] = Entry{b, c};
+            m_entries[m_offsets[b]++] = Entry{a, c};
+            m_entries[m_offsets[c]++] = Entry{a, b};
+        }
+        for (Lit l = num_lits; l > 0; --l) {
+            m_offsets[l] = m_offsets[l - 1];
+        }
+        m_offsets[0] = 0;
+    }
+
+    /**
+     * @brief Get the entries of the clauses containing the given literal.
+     */
+    std::span<const Entry> occurrences_of(Lit l) const noexcept {
+        const Entry* data = m_entries.data();
+        return {data + m_offsets[l], data + m_offsets[l + 1]};
+    }
+
+    /**
+     * @brief Get the number of entries (three per clause).
+     */
+    std::size_t size() const noexcept {
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Get the memory used by the store.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return memory_usage_of(m_offsets) + memory_usage_of(m_entries);
+    }
+
+  private:
+    // CSR offsets (one per literal, plus one).
+    Vector<ClauseRef> m_offsets;
+    // CSR entry block.
+    Vector<Entry> m_entries;
+};
+
+/**
+ * @brief Ternary clause storage using the default allocator.
+ */
+using TernaryClauseStore = BasicTernaryClauseStore<>;
+
+}
+}
+
+#endif
+/// End original header: 'ternary_clause_store.h'
+
+/// Original header: #include "clause_header.h"
+#ifndef SP_CLAUSE_HEADER_H_INCLUDED_
+#define SP_CLAUSE_HEADER_H_INCLUDED_
+
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Compact metadata of a clause of length > 2.
+ * Stored as a single word in the clause arena, directly in front of
+ * the length word of the clause, so that it can be reached from a
+ * ClauseRef without a side table.
+ * Layout (from the least significant bit):
+ *  - bit 0: learnt flag,
+ *  - bit 1: garbage flag (marked for deletion),
+ *  - bit 2: used flag (used in conflict analysis since the last reduction),
+ *  - bit 3: locked flag (temporarily set for reason clauses during reduction),
+ *  - bits 4-11: LBD (saturating),
+ *  - bits 12-31: activity (saturating).
+ * Original clauses are immutable and never deleted; for them,
+ * bits 1-31 instead hold the index of the clause among all
+ * original clauses of length > 2, and all other accessors
+ * are only meaningful for learnt clauses.
+ */
+class ClauseHeader {
+    static constexpr Lit learnt_bit = 1;
+    static constexpr Lit garbage_bit = 2;
+    static constexpr Lit used_bit = 4;
+    static constexpr Lit locked_bit = 8;
+    static constexpr unsigned lbd_shift = 4;
+    static constexpr unsigned activity_shift = 12;
+
+  public:
+    static constexpr std::uint32_t max_lbd = 0xff;
+    static constexpr std::uint32_t max_activity = 0xfffff;
+
+    /**
+     * @brief Create the header of an original clause.
+     */
+    ClauseHeader() noexcept = default;
+
+    /**
+     * @brief Reinterpret a word from the clause arena as header.
+     */
+    explicit ClauseHeader(Lit raw) noexcept : bits(raw) {}
+
+    /**
+     * @brief Create the header of the original clause with the given index.
+     */
+    static ClauseHeader original(std::uint32_t index) noexcept {
+        return ClauseHeader{Lit(index) << 1};
+    }
+
+    /**
+     * @brief Create the header of a learnt clause with the given LBD.
+     */
+    static ClauseHeader learnt(std::uint32_t lbd) noexcept {
+        ClauseHeader result{learnt_bit};
+        result.set_lbd(lbd);
+        return result;
+    }
+
+    /**
+     * @brief Get the raw word that is stored in the clause arena.
+     */
+    Lit raw() const noexcept { return bits; }
+
+    bool is_learnt() const noexcept { return bits & learnt_bit; }
+
+    /**
+     * @brief Get the index of an original clause.
+     */
+    std::uint32_t original_index() const noexcept { return bits >> 1; }
+
+    bool is_garbage() const noexcept { return bits & garbage_bit; }
+    bool is_used() const noexcept { return bits & used_bit; }
+    bool is_locked() const noexcept { return bits & locked_bit; }
+
+    void set_garbage(bool v) noexcept { p_set_flag(garbage_bit, v); }
+    void set_used(bool v) noexcept { p_set_flag(used_bit, v); }
+    void set_locked(bool v) noexcept { p_set_flag(locked_bit, v); }
+
+    std::uint32_t lbd() const noexcept {
+        return (bits >> lbd_shift) & max_lbd;
+    }
+
+    void set_lbd(std::uint32_t lbd) noexcept {
+        lbd = (std::min)(lbd, max_lbd);
+        bits = (bits & ~(Lit(max_lbd) << lbd_shift)) | (Lit(lbd) << lbd_shift);
+    }
+
+    std::uint32_t activity() const noexcept {
+        return bits >> activity_shift;
+    }
+
+    /**
+     * @brief Increase the activity by one (saturating).
+     */
+    void bump_activity() noexcept {
+        if (activity() < max_activity) {
+            bits += Lit(1) << activity_shift;
+        }
+    }
+
+    /**
+     * @brief Halve the activity.
+     */
+    void decay_activity() noexcept {
+        Lit new_activity = activity() >> 1;
+        bits = (bits & ((Lit(1) << activity_shift) - 1)) | (new_activity << activity_shift);
+    }
+
+  private:
+    void p_set_flag(Lit flag, bool v) noexcept {
+        bits = v ? (bits | flag) : (bits & ~flag);
+    }
+
+    Lit bits{0};
+};
+
+static_assert(sizeof(ClauseHeader) == sizeof(Lit), "clause header must fit into one arena word");
+
+}
+}
+
+#endif
+/// End original header: 'clause_header.h'
+
+/// Original header: #include "reason.h"
+#ifndef SP_REASON_H_INCLUDED_
+#define SP_REASON_H_INCLUDED_
+
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief A reason for a propagated literal.
+ * Its either a decision (reason_length == 0),
+ * a unary clause (reason_length == 1, clause in literals[0]),
+ * a binary clause (reason_length == 2, clause in literals),
+ * a clause of length 3 (reason_length == 3, clause in literals),
+ * or a longer clause (clause referred to by clause).
+ * Reasons of length <= 3 are self-contained; only longer
+ * clauses require access to the clause database.
+ */
+struct Reason {
+    /**
+     * @brief Type to create a reason from a decision.
+     */
+    struct Decision {};
+
+    /**
+     * @brief Type to create a reason from a unary clause.
+     */
+    struct Unary {
+        Lit lit;
+    };
+
+    /**
+     * @brief Type to create a reason from a binary clause.
+     */
+    struct Binary {
+        Lit lit1, lit2;
+    };
+
+    /**
+     * @brief Type to create a reason from a clause of length 3.
+     */
+    struct Ternary {
+        Lit lit1, lit2, lit3;
+    };
+
+    /**
+     * @brief Type to create a reason from a clause of length > 3.
+     */
+    struct Clause {
+        ClauseLen length;
+        ClauseRef clause;
+    };
+
+    /* implicit */ Reason(Decision) noexcept : reason_length(0) {}
+
+    /* implicit */ Reason(Unary unary) noexcept : reason_length(1) {
+        literals[0] = unary.lit;
+    }
+
+    /* implicit */ Reason(Binary b) noexcept : reason_length(2) {
+        literals[0] = b.lit1;
+        literals[1] = b.lit2;
+    }
+
+    /* implicit */ Reason(Ternary t) noexcept : reason_length(3) {
+        literals[0] = t.lit1;
+        literals[1] = t.lit2;
+        literals[2] = t.lit3;
+    }
+
+    /* implicit */ Reason(Clause c) noexcept : reason_length(c.length) {
+        assert(c.length > 3);
+        clause = c.clause;
+    }
+
+    ClauseLen reason_length; //< the length of the reason
+    union {
+        ClauseRef clause; //< the clause reference, if length > 3
+        Lit literals[3];  //< the literals of the reason, if length <= 3
+    };
+
+    /**
+     * @brief Check whether this reason refers to a clause in the clause database.
+     */
+    bool is_clause_ref() const noexcept {
+        return reason_length > 3;
+    }
+
+    /**
+     * No matter the type of reason, this function returns a range of literals.
+     */
+    template<typename ClauseContainer>
+    ClausePtrRange lits(const ClauseContainer& db) const noexcept {
+        switch (reason_length) {
+        case 0:
+            return {nullptr, nullptr};
+        case 1:
+            return {+literals, literals + 1};
+        case 2:
+            return {+literals, literals + 2};
+        case 3:
+            return {+literals, literals + 3};
+        default:
+            return db.lits_of(clause);
+        }
+    }
+};
+
+}
+}
+
+#endif
+/// End original header: 'reason.h'
+
+/// Original header: #include "mapped_arena.h"
+#ifndef SP_MAPPED_ARENA_H_INCLUDED_
+#define SP_MAPPED_ARENA_H_INCLUDED_
+
+
+/**
+ * If defined to 1, the clause arenas of the propagator
+ * (original and learnt clauses) are MappedArenas instead of vectors.
+ * Only available on POSIX systems; the arenas then do not use the
+ * allocator of the propagator.
+ */
+#ifndef SPROP_MAPPED_CLAUSE_ARENA
+#define SPROP_MAPPED_CLAUSE_ARENA 0
+#endif
+
+#if SPROP_MAPPED_CLAUSE_ARENA
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief A vector-like container for trivially copyable elements,
+ *        backed by an anonymous memory mapping.
+ * The arena reserves a range of address space (without committing memory;
+ * pages are committed by the kernel when they are first written) and
+ * requests transparent huge pages for it where available.
+ * Growing within the reservation never moves the elements; growing beyond it
+ * doubles the reservation, which on Linux remaps the existing pages instead
+ * of copying them. Shrinking returns the pages beyond the new size to the system.
+ */
+template<typename T>
+class MappedArena {
+    static_assert(std::is_trivially_copyable_v<T>, "mapped arena elements must be trivially copyable");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief The initial amount of address space reserved (in bytes).
+     */
+    static constexpr std::size_t initial_reservation = std::size_t(64) << 20;
+
+    MappedArena() noexcept = default;
+
+    /**
+     * @brief For compatibility with allocator-aware containers;
+     *        the allocator is ignored.
+     */
+    template<typename Allocator>
+    explicit MappedArena(const Allocator&) noexcept {}
+
+    MappedArena(const MappedArena& other) {
+        p_assign(other);
+    }
+
+    MappedArena(MappedArena&& other) noexcept {
+        p_swap(other);
+    }
+
+    MappedArena& operator=(const MappedArena& other) {
+        if (this != &other) {
+            p_assign(other);
+        }
+        return *this;
+    }
+
+    MappedArena& operator=(MappedArena&& other) noexcept {
+        MappedArena tmp(std::move(other));
+        p_swap(tmp);
+        return *this;
+    }
+
+    ~MappedArena() {
+        if (m_base) {
+            ::munmap(m_base, m_reserved);
+        }
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief The number of elements that fit into the reserved address space.
+     */
+    std::size_t capacity() const noexcept { return m_reserved / sizeof(T); }
+
+    T* data() noexcept { return static_cast<T*>(m_base); }
+    const T* data() const noexcept { return static_cast<const T*>(m_base); }
+    T* begin() noexcept { return data(); }
+    const T* begin() const noexcept { return data(); }
+    T* end() noexcept { return data() + m_size; }
+    const T* end() const noexcept { return data() + m_size; }
+    T& operator[](std::size_t i) noexcept { return data()[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+
+    void reserve(std::size_t n) {
+        if (n > capacity()) {
+            p_reserve_bytes(n * sizeof(T));
+        }
+    }
+
+    void push_back(const T& value) {
+        if (m_size == capacity()) {
+            p_reserve_bytes((m_size + 1) * sizeof(T));
+        }
+        data()[m_size++] = value;
+    }
+
+    /**
+     * @brief Insert the elements of [first, last) before pos.
+     */
+    template<typename ForwardIterator>
+    T* insert(const T* pos, ForwardIterator first, ForwardIterator last) {
+        std::size_t offset = std::size_t(pos - data());
+        std::size_t count = std::size_t(std::distance(first, last));
+        reserve(m_size + count);
+        T* at = data() + offset;
+        std::memmove(at + count, at, (m_size - offset) * sizeof(T));
+        std::copy(first, last, at);
+        m_size += count;
+        return at;
+    }
+
+    void resize(std::size_t n) {
+        if (n > m_size) {
+            reserve(n);
+            std::fill(data() + m_size, data() + n, T{});
+        } else {
+            p_release_pages_from(n * sizeof(T));
+        }
+        m_size = n;
+    }
+
+    void clear() noexcept {
+        p_release_pages_from(0);
+        m_size = 0;
+    }
+
+    /**
+     * @brief Get the memory used by the arena; reserved counts
+     *        the reserved address space, not committed memory.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return MemoryUsage{m_size * sizeof(T), m_reserved};
+    }
+
+  private:
+    static std::size_t p_page_size() noexcept {
+        static const std::size_t page_size = std::size_t(::sysconf(_SC_PAGESIZE));
+        return page_size;
+    }
+
+    void p_reserve_bytes(std::size_t bytes) {
+        std::size_t new_reserved = (std::max)(m_reserved, initial_reservation);
+        while (new_reserved < bytes) {
+            new_reserved *= 2;
+        }
+        if (new_reserved == m_reserved)
+            return;
+        void* new_base = MAP_FAILED;
+        if (!m_base) {
+            new_base = ::mmap(nullptr, new_reserved, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        } else {
+#if defined(__linux__)
+            new_base = ::mremap(m_base, m_reserved, new_reserved, MREMAP_MAYMOVE);
+#else
+            new_base = ::mmap(nullptr, new_reserved, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (new_base != MAP_FAILED) {
+                std::memcpy(new_base, m_base, m_size * sizeof(T));
+                ::munmap(m_base, m_reserved);
+            }
+#endif
+        }
+        if (new_base == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+#if defined(MADV_HUGEPAGE)
+        ::madvise(new_base, new_reserved, MADV_HUGEPAGE);
+#endif
+        m_base = new_base;
+        m_reserved = new_reserved;
+    }
+
+    void p_release_pages_from(std::size_t bytes) noexcept {
+        if (!m_base)
+            return;
+        std::size_t page = p_page_size();
+        std::size_t first_page = (bytes + page - 1) / page * page;
+        std::size_t used_end = (m_size * sizeof(T) + page - 1) / page * page;
+        if (first_page < used_end) {
+            ::madvise(static_cast<char*>(m_base) + first_page, used_end - first_page, MADV_DONTNEED);
+        }
+    }
+
+    void p_assign(const MappedArena& other) {
+        clear();
+        reserve(other.m_size);
+        if (other.m_size) {
+            std::memcpy(m_base, other.m_base, other.m_size * sizeof(T));
+        }
+        m_size = other.m_size;
+    }
+
+    void p_swap(MappedArena& other) noexcept {
+        std::swap(m_base, other.m_base);
+        std::swap(m_size, other.m_size);
+        std::swap(m_reserved, other.m_reserved);
+    }
+
+    // The beginning of the mapping (nullptr if nothing is reserved).
+    void* m_base{nullptr};
+    // The number of elements.
+    std::size_t m_size{0};
+    // The number of bytes of reserved address space.
+    std::size_t m_reserved{0};
+};
+
+/**
+ * @brief Get the memory used by a mapped arena.
+ */
+template<typename T>
+MemoryUsage memory_usage_of(const MappedArena<T>& arena) noexcept {
+    return arena.memory_usage();
+}
+
+}
+}
+
+#endif
+
+#endif
+/// End original header: 'mapped_arena.h'
+
+/// Original header: #include "eliminate_subsumed.h"
+#ifndef SP_ELIMINATE_SUBSUMED_H_INCLUDED_
+#define SP_ELIMINATE_SUBSUMED_H_INCLUDED_
+
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Class to implement elimination of subsumed clauses
+ * using a 2-watch scheme.
+ */
+template<typename ClauseType>
+class SubsumptionChecker {
+  public:
+    SubsumptionChecker(std::vector<ClauseType>& clauses, Var n_all) :
+        m_nv(n_all),
+        m_nl(2 * n_all),
+        m_clauses(clauses),
+        m_in_clause(m_nl),
+        m_watching_clauses(m_nl)
+    {
+        p_init_watches();
+    }
+
+    void remove_subsumed() {
+        for(ClauseRef c = 0, n = m_clauses.size(); c < n; ++c) {
+            p_empty_if_subsumed(c);
+        }
+        auto deleted_begin = std::remove_if(m_clauses.begin(), m_clauses.end(), 
+                                            [] (const ClauseType& cl) { return cl.empty(); });
+        m_clauses.erase(deleted_begin, m_clauses.end());
+    }
+
+  private:
+    bool p_walk_watch_list(ClauseRef index, Lit l) {
+        auto& watch_list = m_watching_clauses[l];
+        auto end = watch_list.end();
+        auto out = watch_list.begin();
+        bool subsumed = false;
+        for(auto in = watch_list.begin(); in != end; ++in) {
+            ClauseRef cother = *in;
+            // we cannot subsume ourself. stay in the watch list.
+            if(cother == index) { *out++ = cother; continue; }
+            const ClauseType& other_lits = m_clauses[cother];
+            // subsumed clauses do not participate in subsumption anymore;
+            // they are dropped from watch lists without replacement when we
+            // encounter them here.
+            if(other_lits.empty()) { continue; }
+            // find replacement watch (must not be in the current clause).
+            auto replacement = std::find_if(other_lits.begin(), other_lits.end(), [&] (Lit l) {
+                return !m_in_clause.count(l);
+            });
+            if(replacement == other_lits.end()) {
+                // cother subsumes us.
+                subsumed = true;
+                // copy remaining watching clauses.
+                out = std::copy(in, end, out);
+                break;
+            } else {
+                // cother does not subsume us.
+                m_watching_clauses[*replacement].push_back(cother);
+            }
+        }
+        // trim watch list
+        watch_list.erase(out, end);
+        return subsumed;
+    }
+
+    void p_empty_if_subsumed(ClauseRef index) {
+        ClauseType& clause = m_clauses[index];
+        m_in_clause.assign(clause.begin(), clause.end());
+        for(Lit l : clause) {
+            if(p_walk_watch_list(index, l)) {
+                clause.clear();
+                return;
+            }
+        }
+    }
+
+    void p_init_watches() {
+        for(std::size_t ci = 0, cn = m_clauses.size(); ci < cn; ++ci) {
+            const auto& cl = m_clauses[ci];
+            m_watching_clauses[cl[0]].push_back(ClauseRef(ci));
+        }
+    }
+
+    Var m_nv;
+    Lit m_nl;
+    std::vector<ClauseType>& m_clauses;
+    StampSet<Lit, std::uint16_t> m_in_clause;
+    std::vector<std::vector<ClauseRef>> m_watching_clauses;
+};
+
+/**
+ * @brief Eliminate subsumed clauses from a vector of clauses.
+ */
+template<typename ClauseType>
+inline void eliminate_subsumed(std::vector<ClauseType>& clauses, Var n_all) {
+    SubsumptionChecker<ClauseType> subsumption_checker{clauses, n_all};
+    subsumption_checker.remove_subsumed();
+}
+
+}
+}
+
+#endif
+/// End original header: 'eliminate_subsumed.h'
+
+/// Original header: #include "binary_clause_store.h"
+#ifndef SP_BINARY_CLAUSE_STORE_H_INCLUDED_
+#define SP_BINARY_CLAUSE_STORE_H_INCLUDED_
+
+
+namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
+
+/**
+ * @brief Storage for binary clauses, indexed by literal.
+ * The partners of all literals are stored in a single compressed
+ * sparse row (CSR) block: the partners of literal l are
+ * m_partners[m_offsets[l]] to m_partners[m_offsets[l+1]].
+ * Binary clauses that are added after construction (e.g., learnt clauses)
+ * go into a small overflow area, which consists of one singly-linked list
+ * per literal, stored in one flat pool; it can be merged back into the CSR
+ * block on demand.
+ * Ranges of partners can be prefixed by a span of partners from another
+ * (e.g., shared and immutable) store.
+ * All memory is obtained from the given allocator (rebound as necessary).
+ */
+template<typename Allocator = std::allocator<Lit>>
+class BasicBinaryClauseStore {
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+    /**
+     * An entry in the overflow pool.
+     */
+    struct OverflowEntry {
+        Lit partner;
+        Lit next;
+    };
+
+  public:
+    /**
+     * @brief Iterator over the partners of a literal,
+     *        first in the prefix span, then in the CSR block,
+     *        then in the overflow area.
+     */
+    class PartnerIterator {
+      public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = Lit;
+        using difference_type = std::ptrdiff_t;
+
+        PartnerIterator() noexcept = default;
+
+        PartnerIterator(std::span<const Lit> prefix, std::span<const Lit> csr,
+                        const OverflowEntry* pool, Lit entry) noexcept :
+            m_prefix(prefix.data()), m_prefix_end(prefix.data() + prefix.size()),
+            m_csr(csr.data()), m_csr_end(csr.data() + csr.size()), 
+            m_pool(pool), m_entry(entry)
+        {}
+
+        Lit operator*() const noexcept {
+            if (m_prefix != m_prefix_end)
+                return *m_prefix;
+            return m_csr != m_csr_end ? *m_csr : m_pool[m_entry].partner;
+        }
+
+        PartnerIterator& operator++() noexcept {
+            if (m_prefix != m_prefix_end) {
+                ++m_prefix;
+            } else if (m_csr != m_csr_end) {
+                ++m_csr;
+            } else {
+                m_entry = m_pool[m_entry].next;
+            }
+            return *this;
+        }
+
+        PartnerIterator operator++(int) noexcept {
+            PartnerIterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return m_prefix == m_prefix_end && m_csr == m_csr_end && m_entry == NIL;
+        }
+
+      private:
+        const Lit* m_prefix{nullptr};
+        const Lit* m_prefix_end{nullptr};
+        const Lit* m_csr{nullptr};
+        const Lit* m_csr_end{nullptr};
+        const OverflowEntry* m_pool{nullptr};
+        Lit m_entry{NIL};
+    };
+
+    /**
+     * @brief Range over the partners of a literal.
+     */
+    class PartnerRange {
+      public:
+        PartnerRange(PartnerIterator begin) noexcept : m_begin(begin) {}
+
+        PartnerIterator begin() const noexcept { return m_begin; }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+      private:
+        PartnerIterator m_begin;
+    };
+
+    explicit BasicBinaryClauseStore(const Allocator& alloc = Allocator()) : 
+        m_offsets(1, 0, alloc), m_partners(alloc), m_overflow_heads(alloc), m_overflow(alloc)
+    {}
+
+    BasicBinaryClauseStore(const BasicBinaryClauseStore&) = default;
+    BasicBinaryClauseStore(BasicBinaryClauseStore&&) = default;
+    BasicBinaryClauseStore& operator=(const BasicBinaryClauseStore&) = default;
+    BasicBinaryClauseStore& operator=(BasicBinaryClauseStore&&) = default;
+
+    /**
+     * @brief Copy the given store, using the given allocator.
+     */
+    BasicBinaryClauseStore(const BasicBinaryClauseStore& other, const Allocator& alloc) :
+        m_offsets(other.m_offsets, alloc), m_partners(other.m_partners, alloc),
+        m_overflow_heads(other.m_overflow_heads, alloc), m_overflow(other.m_overflow, alloc)
+    {}
+
+    /**
+     * @brief Build the CSR block from a list of partners for each literal;
+     *        lists may be shorter than num_lits and contain duplicates.
+     */
+    void build(const std::vector<std::vector<Lit>>& partner_lists, Lit num_lits) {
+        m_offsets.assign(num_lits + 1, 0);
+        m_partners.clear();
+        m_overflow_heads.clear();
+        m_overflow.clear();
+        std::size_t total = 0;
+        for (const auto& list : partner_lists) {
+            total += list.size();
+        }
+        m_partners.reserve(total);
+        for (Lit l = 0; l < num_lits; ++l) {
+            m_offsets[l] = ClauseRef(m_partners.size());
+            if (l < partner_lists.size()) {
+                const auto& list = partner_lists[l];
+                auto begin = m_partners.insert(m_partners.end(), list.begin(), list.end());
+                std::sort(begin, m_partners.end());
+                m_partners.erase(std::unique(begin, m_partners.end()), m_partners.end());
+            }
+        }
+        p_check_csr_size(m_partners.size());
+        m_offsets[num_lits] = ClauseRef(m_partners.size());
+    }
+
+    /**
+     * @brief Add a binary clause to the overflow area.
+     */
+    void add(Lit l1, Lit l2) {
+        if (m_overflow_heads.empty()) {
+            m_overflow_heads.assign(num_lits(), NIL);
+        }
+        p_add_overflow(l1, l2);
+        p_add_overflow(l2, l1);
+    }
+
+    /**
+     * @brief Get the partners of the given literal in the CSR block.
+     */
+    std::span<const Lit> csr_partners_of(Lit l) const noexcept {
+        const Lit* data = m_partners.data();
+        return {data + m_offsets[l], data + m_offsets[l + 1]};
+    }
+
+    /**
+     * @brief Call f for each partner of the given literal in the overflow area.
+     */
+    template<typename Callable>
+    bool all_overflow_partners_of(Lit l, Callable&& f) const {
+        if (m_overflow_heads.empty())
+            return true;
+        for (Lit e = m_overflow_heads[l]; e != NIL; e = m_overflow[e].next) {
+            if (!f(m_overflow[e].partner))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get a range of all partners of the given literal,
+     *        preceded by the given prefix.
+     */
+    PartnerRange partners_of(Lit l, std::span<const Lit> prefix = {}) const noexcept {
+        Lit head = m_overflow_heads.empty() ? NIL : m_overflow_heads[l];
+        return PartnerIterator{prefix, csr_partners_of(l), m_overflow.data(), head};
+    }
+
+    /**
+     * @brief Get the number of literals.
+     */
+    Lit num_lits() const noexcept {
+        return Lit(m_offsets.size() - 1);
+    }
+
+    /**
+     * @brief Get the number of entries (two per clause) in the overflow area.
+     */
+    std::size_t overflow_size() const noexcept {
+        return m_overflow.size();
+    }
+
+    /**
+     * @brief Get the number of entries (two per clause) in the CSR block.
+     */
+    std::size_t csr_size() const noexcept {
+        return m_partners.size();
+    }
+
+    /**
+     * @brief Get the memory used by the store.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        return memory_usage_of(m_offsets) + memory_usage_of(m_partners) +
+               memory_usage_of(m_overflow_heads) + memory_usage_of(m_overflow);
+    }
+
+    /**
+     * @brief Merge the overflow area into the CSR block.
+     * Linear in the total number of binary clauses.
+     */
+    void merge_overflow() {
+        if (m_overflow.empty())
+            return;
+        const Lit nl = num_lits();
+        Vector<ClauseRef> new_offsets(nl + 1, 0, m_offsets.get_allocator());
+        Vector<Lit> new_partners(m_partners.get_allocator());
+        new_partners.reserve(m_partners.size() + m_overflow.size());
+        for (Lit l = 0; l < nl; ++l) {
+            new_offsets[l] = ClauseRef(new_partners.size());
+            std::span<const Lit> csr = csr_partners_of(l);
+            new_partners.insert(new_partners.end(), csr.begin(), csr.end());
+            all_overflow_partners_of(l, [&] (Lit p) { new_partners.push_back(p); return true; });
+        }
+        p_check_csr_size(new_partners.size());
+        new_offsets[nl] = ClauseRef(new_partners.size());
+        m_offsets = std::move(new_offsets);
+        m_partners = std::move(new_partners);
+        m_overflow_heads.clear();
+        m_overflow.clear();
+    }
+
+  private:
+    /**
+     * The CSR offsets are ClauseRefs; make sure that a
+     * partner block of the given size can be indexed by them.
+     * As the offsets only grow, checking the final size suffices.
+     */
+    static void p_check_csr_size(std::size_t size) {
+        if (size > std::numeric_limits<ClauseRef>::max()) {
+            throw std::length_error("Too many binary clauses for the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
+        }
+    }
+
+    void p_add_overflow(Lit l, Lit partner) {
+        if (m_overflow.size() >= NIL) {
+            throw std::length_error("Too many learnt binary clauses for the configured index widths (see SPROP_LIT_BITS)!");
+        }
+        Lit index(m_overflow.size());
+        m_overflow.push_back(OverflowEntry{partner, m_overflow_heads[l]});
+        m_overflow_heads[l] = index;
+    }
+
+    // CSR offsets (one per literal, plus one).
+    Vector<ClauseRef> m_offsets;
+    // CSR partner block.
+    Vector<Lit> m_partners;
+    // The first overflow entry of each literal (NIL if there is none);
+    // empty as long as there are no overflow entries.
+    Vector<Lit> m_overflow_heads;
+    // The overflow pool.
+    Vector<OverflowEntry> m_overflow;
+};
 
 /**
- * @brief Check if a literal is false in a given assignment.
+ * @brief Binary clause storage using the default allocator.
  */
-template<typename BitsetType>
-static inline bool is_false_in(Lit l, const BitsetType& assignment) noexcept
-{
-    return !is_true_in(l, assignment);
-}
+using BinaryClauseStore = BasicBinaryClauseStore<>;
 
 }
 }
 
 #endif
-/// End original header: 'literal_ops.h'
+/// End original header: 'binary_clause_store.h'
 
-/// Original header: #include "eliminate_subsumed.h"
-#ifndef SP_ELIMINATE_SUBSUMED_H_INCLUDED_
-#define SP_ELIMINATE_SUBSUMED_H_INCLUDED_
+/// Original header: #include "slab_list_store.h"
+#ifndef SP_SLAB_LIST_STORE_H_INCLUDED_
+#define SP_SLAB_LIST_STORE_H_INCLUDED_
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
- * @brief Class to implement elimination of subsumed clauses
- * using a 2-watch scheme.
+ * @brief Storage for many growable lists (e.g., watch lists) in a single slab.
+ * Each non-empty list occupies a block of the slab whose capacity is
+ * given by a size class (min_capacity << size_class). When a list
+ * outgrows its block, it moves to a block of the next size class, which
+ * is taken from the free list of that class or appended to the slab
+ * (the block at the end of the slab is grown in place); the old block is
+ * put on the free list of its class. compact() restores locality by laying
+ * out all lists contiguously in list order.
+ * Growing a list may move the entire slab, invalidating pointers
+ * and spans into all lists.
  */
-template<typename ClauseType>
-class SubsumptionChecker {
+template<typename Entry, typename Allocator = std::allocator<Entry>>
+class SlabListStore {
+    static_assert(std::is_trivially_copyable_v<Entry>, "slab entries must be trivially copyable");
+
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+    static constexpr std::uint32_t no_block = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * The position, size and size class of a list.
+     */
+    struct ListInfo {
+        std::size_t offset{0};
+        std::uint32_t size{0};
+        std::uint32_t size_class{no_block};
+    };
+
   public:
-    SubsumptionChecker(std::vector<ClauseType>& clauses, Var n_all) :
-        m_nv(n_all),
-        m_nl(2 * n_all),
-        m_clauses(clauses),
-        m_in_clause(m_nl),
-        m_watching_clauses(m_nl)
-    {
-        p_init_watches();
+    /**
+     * @brief The capacity of the smallest size class.
+     */
+    static constexpr std::uint32_t min_capacity = 4;
+
+    explicit SlabListStore(const Allocator& alloc = Allocator()) :
+        m_slab(alloc), m_lists(alloc), m_free_blocks(alloc)
+    {}
+
+    /**
+     * @brief Get the number of lists.
+     */
+    std::size_t num_lists() const noexcept {
+        return m_lists.size();
     }
 
-    void remove_subsumed() {
-        for(ClauseRef c = 0, n = m_clauses.size(); c < n; ++c) {
-            p_empty_if_subsumed(c);
+    /**
+     * @brief Change the number of lists; new lists are empty.
+     */
+    void resize(std::size_t num_lists) {
+        for (std::size_t l = num_lists; l < m_lists.size(); ++l) {
+            p_release_block(m_lists[l]);
         }
-        auto deleted_begin = std::remove_if(m_clauses.begin(), m_clauses.end(), 
-                                            [] (const ClauseType& cl) { return cl.empty(); });
-        m_clauses.erase(deleted_begin, m_clauses.end());
+        m_lists.resize(num_lists);
+    }
+
+    /**
+     * @brief Get the size of the given list.
+     */
+    std::uint32_t size(std::size_t list) const noexcept {
+        return m_lists[list].size;
+    }
+
+    /**
+     * @brief Get the capacity of the given list.
+     */
+    std::size_t capacity(std::size_t list) const noexcept {
+        return p_capacity_of(m_lists[list].size_class);
+    }
+
+    /**
+     * @brief Get a pointer to the first entry of the given list.
+     */
+    Entry* data(std::size_t list) noexcept {
+        return m_slab.data() + m_lists[list].offset;
+    }
+
+    const Entry* data(std::size_t list) const noexcept {
+        return m_slab.data() + m_lists[list].offset;
+    }
+
+    std::span<Entry> operator[](std::size_t list) noexcept {
+        return {data(list), size(list)};
+    }
+
+    std::span<const Entry> operator[](std::size_t list) const noexcept {
+        return {data(list), size(list)};
+    }
+
+    /**
+     * @brief Append an entry to the given list.
+     */
+    void push_back(std::size_t list, const Entry& entry) {
+        ListInfo& info = m_lists[list];
+        if (info.size == p_capacity_of(info.size_class)) {
+            p_grow(info);
+        }
+        m_slab[info.offset + info.size++] = entry;
+    }
+
+    /**
+     * @brief Shrink the given list to the given size (keeping its block).
+     */
+    void truncate(std::size_t list, std::uint32_t new_size) noexcept {
+        m_lists[list].size = (std::min)(m_lists[list].size, new_size);
+    }
+
+    /**
+     * @brief Lay out all lists contiguously in list order, each in the
+     *        smallest size class that fits it, and drop all free blocks.
+     */
+    void compact() {
+        std::size_t total = 0;
+        for (const ListInfo& info : m_lists) {
+            total += p_capacity_of(p_size_class_for(info.size));
+        }
+        Vector<Entry> new_slab(m_slab.get_allocator());
+        new_slab.reserve(total);
+        for (ListInfo& info : m_lists) {
+            std::uint32_t new_class = p_size_class_for(info.size);
+            std::size_t new_offset = new_slab.size();
+            const Entry* begin = m_slab.data() + info.offset;
+            new_slab.insert(new_slab.end(), begin, begin + info.size);
+            new_slab.resize(new_offset + p_capacity_of(new_class));
+            info.offset = new_class == no_block ? 0 : new_offset;
+            info.size_class = new_class;
+        }
+        m_slab = std::move(new_slab);
+        m_free_blocks.clear();
+    }
+
+    /**
+     * @brief Get the number of slab entries in blocks on the free lists.
+     */
+    std::size_t free_entries() const noexcept {
+        std::size_t result = 0;
+        for (std::uint32_t c = 0; c < m_free_blocks.size(); ++c) {
+            result += m_free_blocks[c].size() * p_capacity_of(c);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the memory used by the store; only the entries
+     *        in lists count as used, all other slab entries as slack.
+     */
+    MemoryUsage memory_usage() const noexcept {
+        std::size_t used_entries = 0;
+        for (const ListInfo& info : m_lists) {
+            used_entries += info.size;
+        }
+        MemoryUsage result{used_entries * sizeof(Entry), m_slab.capacity() * sizeof(Entry)};
+        return result + memory_usage_of(m_lists) + memory_usage_of(m_free_blocks);
     }
 
   private:
-    bool p_walk_watch_list(ClauseRef index, Lit l) {
-        auto& watch_list = m_watching_clauses[l];
-        auto end = watch_list.end();
-        auto out = watch_list.begin();
-        bool subsumed = false;
-        for(auto in = watch_list.begin(); in != end; ++in) {
-            ClauseRef cother = *in;
-            // we cannot subsume ourself. stay in the watch list.
-            if(cother == index) { *out++ = cother; continue; }
-            const ClauseType& other_lits = m_clauses[cother];
-            // subsumed clauses do not participate in subsumption anymore;
-            // they are dropped from watch lists without replacement when we
-            // encounter them here.
-            if(other_lits.empty()) { continue; }
-            // find replacement watch (must not be in the current clause).
-            auto replacement = std::find_if(other_lits.begin(), other_lits.end(), [&] (Lit l) {
-                return !m_in_clause.count(l);
-            });
-            if(replacement == other_lits.end()) {
-                // cother subsumes us.
-                subsumed = true;
-                // copy remaining watching clauses.
-                out = std::copy(in, end, out);
-                break;
-            } else {
-                // cother does not subsume us.
-                m_watching_clauses[*replacement].push_back(cother);
-            }
+    static std::size_t p_capacity_of(std::uint32_t size_class) noexcept {
+        return size_class == no_block ? 0 : std::size_t(min_capacity) << size_class;
+    }
+
+    static std::uint32_t p_size_class_for(std::size_t size) noexcept {
+        if (size == 0)
+            return no_block;
+        std::uint32_t result = 0;
+        while (p_capacity_of(result) < size)
+            ++result;
+        return result;
+    }
+
+    void p_grow(ListInfo& info) {
+        std::uint32_t new_class = info.size_class == no_block ? 0 : info.size_class + 1;
+        std::size_t old_capacity = p_capacity_of(info.size_class);
+        if (old_capacity != 0 && info.offset + old_capacity == m_slab.size()) {
+            // the block is at the end of the slab: grow in place
+            m_slab.resize(info.offset + p_capacity_of(new_class));
+            info.size_class = new_class;
+            return;
         }
-        // trim watch list
-        watch_list.erase(out, end);
-        return subsumed;
+        std::size_t new_offset = p_allocate_block(new_class);
+        std::copy_n(m_slab.data() + info.offset, info.size, m_slab.data() + new_offset);
+        p_release_block(info);
+        info.offset = new_offset;
+        info.size_class = new_class;
     }
 
-    void p_empty_if_subsumed(ClauseRef index) {
-        ClauseType& clause = m_clauses[index];
-        m_in_clause.assign(clause.begin(), clause.end());
-        for(Lit l : clause) {
-            if(p_walk_watch_list(index, l)) {
-                clause.clear();
-                return;
-            }
+    std::size_t p_allocate_block(std::uint32_t size_class) {
+        if (size_class < m_free_blocks.size() && !m_free_blocks[size_class].empty()) {
+            std::size_t result = m_free_blocks[size_class].back();
+            m_free_blocks[size_class].pop_back();
+            return result;
         }
+        std::size_t result = m_slab.size();
+        m_slab.resize(result + p_capacity_of(size_class));
+        return result;
     }
 
-    void p_init_watches() {
-        for(std::size_t ci = 0, cn = m_clauses.size(); ci < cn; ++ci) {
-            const auto& cl = m_clauses[ci];
-            m_watching_clauses[cl[0]].push_back(ClauseRef(ci));
+    void p_release_block(const ListInfo& info) {
+        if (info.size_class == no_block)
+            return;
+        if (m_free_blocks.size() <= info.size_class) {
+            m_free_blocks.resize(info.size_class + 1);
         }
+        m_free_blocks[info.size_class].push_back(info.offset);
     }
 
-    Var m_nv;
-    Lit m_nl;
-    std::vector<ClauseType>& m_clauses;
-    StampSet<Lit, std::uint16_t> m_in_clause;
-    std::vector<std::vector<ClauseRef>> m_watching_clauses;
+    // The slab containing all blocks.
+    Vector<Entry> m_slab;
+    // The position, size and size class of each list.
+    Vector<ListInfo> m_lists;
+    // For each size class, the offsets of the free blocks.
+    Vector<Vector<std::size_t>> m_free_blocks;
 };
 
-/**
- * @brief Eliminate subsumed clauses from a vector of clauses.
- */
-template<typename ClauseType>
-inline void eliminate_subsumed(std::vector<ClauseType>& clauses, Var n_all) {
-    SubsumptionChecker<ClauseType> subsumption_checker{clauses, n_all};
-    subsumption_checker.remove_subsumed();
 }
-
 }
 
 #endif
-/// End original header: 'eliminate_subsumed.h'
+/// End original header: 'slab_list_store.h'
 
 /// Original header: #include "model_builder.h"
 #ifndef SP_MODEL_BUILDER_H_INCLUDED_
@@ -487,6 +1883,7 @@ inline void eliminate_subsumed(std::vector<ClauseType>& clauses, Var n_all) {
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 /**
  * @brief A class that helps building a SAT formula.
@@ -494,8 +1891,22 @@ namespace sprop {
  */
 class ModelBuilder {
   public:
-    friend class Propagator;
+    template<typename Allocator> friend class BasicPropagator;
     
+    /**
+     * @brief Breakdown of the memory used by a ModelBuilder.
+     */
+    struct MemoryBreakdown {
+        MemoryUsage unary_clauses;
+        MemoryUsage binary_clauses;
+        MemoryUsage longer_clauses;
+        MemoryUsage buffers;
+
+        MemoryUsage total() const noexcept {
+            return unary_clauses + binary_clauses + longer_clauses + buffers;
+        }
+    };
+
     ModelBuilder() = default;
 
     /**
@@ -571,7 +1982,7 @@ class ModelBuilder {
     /**
      * Verify that the given trail is a valid assignment for the model.
      */
-    std::optional<std::string> verify_trail(const std::vector<Lit>& full_trail) {
+    std::optional<std::string> verify_trail(std::span<const Lit> full_trail) {
         auto n = lit::var(m_current_lit);
         if(full_trail.size() != n) {
             return std::format("Trail has wrong length: expected {}, got {}", n, full_trail.size());
@@ -634,6 +2045,18 @@ class ModelBuilder {
         return std::nullopt;
     }
 
+    /**
+     * @brief Get the memory currently used by the model.
+     */
+    MemoryBreakdown memory_usage() const noexcept {
+        return MemoryBreakdown{
+            memory_usage_of(m_unary_clauses),
+            memory_usage_of(m_binary_clauses),
+            memory_usage_of(m_longer_clauses),
+            memory_usage_of(m_current_clause_buffer)
+        };
+    }
+
   private:
     /**
      * Add the current clause to the model and clear it.
@@ -688,6 +2111,7 @@ class ModelBuilder {
     std::vector<Lit> m_current_clause_buffer;
 };
 
+}
 }
 
 #endif
@@ -698,7 +2122,45 @@ class ModelBuilder {
 #define SP_PROPAGATOR_H_INCLUDED_
 
 
+/**
+ * If defined to 1, binary clauses are not kept in a separate
+ * BinaryClauseStore; instead, they are stored as tagged entries
+ * in the same watch lists as the watchers of longer clauses.
+ */
+#ifndef SPROP_INLINE_BINARY_WATCHERS
+#define SPROP_INLINE_BINARY_WATCHERS 0
+#endif
+
+/**
+ * The default number of watchers ahead of the current one for which
+ * propagation prefetches clause memory (see set_prefetch_lookahead).
+ * Defaults to 0 (off), as prefetching slows down propagation
+ * on formulas that fit into the cache.
+ */
+#ifndef SPROP_DEFAULT_PREFETCH_LOOKAHEAD
+#define SPROP_DEFAULT_PREFETCH_LOOKAHEAD 0
+#endif
+
+/**
+ * Learnt clauses of at least this length remember where the last
+ * search for a replacement watch found one, in an extra word after
+ * their literals; the next search continues from there circularly
+ * instead of restarting after the watched literals, which keeps
+ * repeated visits of long clauses from becoming quadratic.
+ * (Original clauses always do this, using their watch slot.)
+ */
+#ifndef SPROP_SAVED_SEARCH_MIN_LENGTH
+#define SPROP_SAVED_SEARCH_MIN_LENGTH 16
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SPROP_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define SPROP_PREFETCH(address) ((void)(address))
+#endif
+
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 namespace detail {
 
 /**
@@ -707,13 +2169,13 @@ namespace detail {
 class VariableState {
     std::int32_t value_code{-1};
     std::uint32_t stamp{0};
-    std::uint32_t trail_pos{NIL};
+    TrailLen trail_pos{std::numeric_limits<TrailLen>::max()};
 
   public:
     /**
      * @brief Get the trail position of the variable.
      */
-    std::uint32_t get_trail_pos() const noexcept { return trail_pos; }
+    TrailLen get_trail_pos() const noexcept { return trail_pos; }
 
     /**
      * @brief Get the current stamp value of the variable.
@@ -728,7 +2190,7 @@ class VariableState {
     /**
      * @brief Assign a value to the variable at a certain level.
      */
-    void assign(std::uint32_t tpos, Lit ltrue, std::int32_t level) {
+    void assign(TrailLen tpos, Lit ltrue, std::int32_t level) {
         value_code = (level << 1) + std::int32_t(ltrue & 1);
         trail_pos = tpos;
     }
@@ -798,7 +2260,7 @@ class VariableState {
  * @brief Information about a decision level in the propagator.
  */
 class LevelInfo {
-    std::uint32_t trail_pos;
+    TrailLen trail_pos;
     std::uint32_t stamp{0};
 
   public:
@@ -806,57 +2268,159 @@ class LevelInfo {
 
     void stamp_with(std::uint32_t v) noexcept { stamp = v; }
 
-    std::uint32_t level_begin() const noexcept { return trail_pos; }
+    TrailLen level_begin() const noexcept { return trail_pos; }
 
-    explicit LevelInfo(std::uint32_t trail_pos) noexcept
+    explicit LevelInfo(TrailLen trail_pos) noexcept
         : trail_pos(trail_pos) {}
 };
 
+/**
+ * @brief The container type of clause arenas.
+ */
+#if SPROP_MAPPED_CLAUSE_ARENA
+template<typename Allocator>
+using ClauseArena = MappedArena<Lit>;
+#else
+template<typename Allocator>
+using ClauseArena = std::vector<Lit, Allocator>;
+#endif
+
+/**
+ * @brief The original (irredundant) clauses of a formula.
+ * Immutable after construction and shared by all copies of a propagator.
+ */
+template<typename Allocator>
+struct OriginalFormula {
+    explicit OriginalFormula(const Allocator& alloc) : 
+        binary_clauses(alloc), ternary_clauses(alloc), clause_db(alloc) 
+    {}
+
+    // The original binary clauses.
+    BasicBinaryClauseStore<Allocator> binary_clauses;
+    // Occurrence lists of the clauses of length 3, used for propagating them.
+    BasicTernaryClauseStore<Allocator> ternary_clauses;
+    // Clauses of length > 2, each stored as [header, length, literals...];
+    // a ClauseRef is the index of the first literal.
+    ClauseArena<Allocator> clause_db;
+    // The number of clauses in clause_db.
+    std::size_t num_clauses{0};
+    // The number of clauses of length 3 in clause_db.
+    std::size_t num_ternary_clauses{0};
+};
+
 } // namespace detail
 
 /**
  * @brief A propagator for a SAT formula.
+ * All internal data structures obtain their memory from an allocator
+ * of the given type (rebound as necessary); use Propagator for the
+ * default allocator and pmr::Propagator for a std::pmr::memory_resource.
  */
-class Propagator {
+template<typename Allocator = std::allocator<Lit>>
+class BasicPropagator {
     using VariableState = detail::VariableState;
     using LevelInfo = detail::LevelInfo;
+    using LitAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Lit>;
+    using OriginalFormula = detail::OriginalFormula<LitAllocator>;
+
+  public:
+    /**
+     * @brief The allocator type used by the propagator.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief The vector type used for the internal data structures,
+     *        some of which are exposed by reference.
+     */
+    template<typename T>
+    using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  private:
 
     /**
      * A watcher for a clause.
      * Each clause watches two literals;
-     * these are rearranged so that the watched
-     * literals are the first two literals in the clause.
+     * for learnt clauses, these are rearranged so that the watched
+     * literals are the first two literals in the clause, and the
+     * watcher refers to the clause by its ClauseRef.
+     * Original clauses are shared and immutable; original clauses of length 3
+     * are not watched, but propagated through the shared occurrence lists in
+     * OriginalFormula::ternary_clauses. For longer original clauses, the watched
+     * literals are kept in a per-instance OriginalWatch slot instead,
+     * and the watcher refers to the index of that slot (which is
+     * always below m_learnt_begin), so that propagation reaches the
+     * watched literals without going through the clause.
      * The blocker is a watched literal and helps us
      * avoid accesses into the large clause array.
+     * With SPROP_INLINE_BINARY_WATCHERS, binary clauses are
+     * represented by watchers with the clause binary_tag;
+     * their blocker is the other literal of the clause.
      */
     struct Watcher {
         Lit blocker;
         ClauseRef clause;
+
+        static constexpr ClauseRef binary_tag = NIL_CLAUSE;
+
+        bool is_binary() const noexcept { return clause == binary_tag; }
+    };
+
+    /**
+     * The watched literals of an original clause of length > 3
+     * in this propagator, together with the clause's ClauseRef
+     * and the position at which the next replacement search starts.
+     */
+    struct OriginalWatch {
+        std::array<Lit, 2> watched;
+        ClauseRef clause;
+        Lit search_pos;
     };
 
-    using WatchList = std::vector<Watcher>;
-    using WatchIter = WatchList::iterator;
+    static constexpr bool inline_binary_watchers = SPROP_INLINE_BINARY_WATCHERS;
+    static constexpr ClauseLen saved_search_min_length = SPROP_SAVED_SEARCH_MIN_LENGTH;
+
+    // all watch lists, stored in a single slab
+    using WatchStore = SlabListStore<Watcher, Allocator>;
   
   public:
     // -------- CONSTRUCTION --------
     /**
      * Create a new propagator without any clauses or variables.
      */
-    inline explicit Propagator();
+    inline explicit BasicPropagator(const Allocator& alloc = Allocator());
 
     /**
      * Create a new propagator from a model/formula.
      */
-    inline explicit Propagator(const ModelBuilder& model);
+    inline explicit BasicPropagator(const ModelBuilder& model, const Allocator& alloc = Allocator());
 
     /**
      * Propagators are copyable/movable.
-     * Copies are essentially linear in the size of the entire structure.
+     * Copies share the (immutable) original clauses; they are essentially 
+     * linear in the number of variables, watchers and learnt clauses.
+     * Copies obtain their allocator as the standard containers do;
+     * for std::pmr, this means that they use the default memory resource.
+     */
+    BasicPropagator(const BasicPropagator&) = default;
+    BasicPropagator(BasicPropagator&&) = default;
+    BasicPropagator& operator=(const BasicPropagator&) = default;
+    BasicPropagator& operator=(BasicPropagator&&) = default;
+
+    /**
+     * Create a copy of the given propagator that uses the given allocator,
+     * e.g., to place a short-lived copy into an arena.
+     * The shared original clauses remain where they are; the allocator of
+     * the propagator they were created by must outlive the copy.
+     */
+    inline BasicPropagator(const BasicPropagator& other, const Allocator& alloc);
+
+    /**
+     * @brief Get the allocator of the propagator.
      */
-    Propagator(const Propagator&) = default;
-    Propagator(Propagator&&) = default;
-    Propagator& operator=(const Propagator&) = default;
-    Propagator& operator=(Propagator&&) = default;
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(trail_lits.get_allocator());
+    }
 
     /// -------- ACCESS OF CLAUSES AND LITERALS --------
     /**
@@ -865,14 +2429,21 @@ class Propagator {
      */
     ClauseRef cref_of(ClausePtrRange lits) const noexcept {
         assert(std::distance(lits.begin(), lits.end()) > 2);
-        return ClauseRef(lits.begin() - m_large_clause_db.data());
+        const Lit* begin = lits.begin();
+        const auto& original_db = m_original->clause_db;
+        if (std::less_equal<const Lit*>{}(original_db.data(), begin) &&
+            std::less<const Lit*>{}(begin, original_db.data() + original_db.size()))
+        {
+            return ClauseRef(begin - original_db.data());
+        }
+        return ClauseRef(begin - m_learnt_clause_db.data()) + m_learnt_begin - 2;
     }
 
     /**
      * @brief Get the literals of a clause longer than 2.
      */
     ClausePtrRange lits_of(ClauseRef clause) const noexcept {
-        const Lit* begin = m_large_clause_db.data() + clause;
+        const Lit* begin = p_clause_begin(clause);
         return std::ranges::subrange(begin, begin + begin[-1]);
     }
 
@@ -880,35 +2451,80 @@ class Propagator {
      * @brief Get the length of a clause (in literals).
      */
     ClauseLen clause_length(ClauseRef clause) const noexcept {
-        return m_large_clause_db[clause - 1];
+        return p_clause_begin(clause)[-1];
+    }
+
+    /**
+     * @brief Get the metadata header of a clause longer than 2.
+     */
+    ClauseHeader header_of(ClauseRef clause) const noexcept {
+        return ClauseHeader{p_clause_begin(clause)[-2]};
+    }
+
+    /**
+     * @brief Check whether a clause longer than 2 is a learnt clause.
+     */
+    bool is_learnt(ClauseRef clause) const noexcept {
+        return header_of(clause).is_learnt();
     }
 
     /**
      * @brief From a clause reference, get the next higher clause reference.
      */
     ClauseRef next_clause(ClauseRef clause) const noexcept {
-        return clause + m_large_clause_db[clause - 1] + 1;
+        ClauseLen length = p_clause_begin(clause)[-1];
+        return clause + length + 2 + (clause >= m_learnt_begin && p_has_saved_search(length));
     }
 
     /**
      * @brief Get a range of all literals in unary clauses.
      */
-    const std::vector<Lit>& unary_clauses() const noexcept {
+    const Vector<Lit>& unary_clauses() const noexcept {
         return m_unary_clauses;
     }
 
     /**
      * @brief Get a range of all literals that occur together with the given literal in a binary clause.
+     * This is an input range (it is neither sized nor random-access); partners
+     * from original binary clauses come first and are free of duplicates.
+     */
+    auto binary_partners_of(Lit lit) const noexcept {
+        if constexpr (inline_binary_watchers) {
+            return watchers[lit]
+                | std::views::filter([] (const Watcher& w) { return w.is_binary(); })
+                | std::views::transform([] (const Watcher& w) { return w.blocker; });
+        } else {
+            return m_binary_clauses.partners_of(lit, m_original->binary_clauses.csr_partners_of(lit));
+        }
+    }
+
+    /**
+     * @brief Get the literals that occur together with the given literal in an
+     *        original (i.e., not learnt) binary clause, sorted and without duplicates.
+     * The span refers to the shared original formula and remains valid
+     * as long as the propagator or any of its copies exists.
+     */
+    std::span<const Lit> original_binary_partners_of(Lit lit) const noexcept {
+        return m_original->binary_clauses.csr_partners_of(lit);
+    }
+
+    /**
+     * @brief Merge the binary clauses learnt since construction (or since
+     * the last merge) into the compact block of learnt binary clauses.
+     * This happens automatically once there are as many new learnt binary
+     * clauses as merged ones (or at least 1024); it invalidates all ranges
+     * obtained from binary_partners_of.
+     * Does nothing with SPROP_INLINE_BINARY_WATCHERS.
      */
-    const std::vector<Lit>& binary_partners_of(Lit lit) const noexcept {
-        return m_binary_clauses[lit];
+    void merge_learnt_binaries() {
+        m_binary_clauses.merge_overflow();
     }
 
     /**
      * @brief Get the ClauseRef of the first clause of length > 2.
      */
     ClauseRef first_longer_clause() const noexcept {
-        return 1;
+        return 2;
     }
 
     /**
@@ -916,7 +2532,7 @@ class Propagator {
      * i.e., what would be returned by next_clause(last_clause).
      */
     ClauseRef longer_clause_end() const noexcept {
-        return m_large_clause_db.size() + 1;
+        return m_learnt_begin + ClauseRef(m_learnt_clause_db.size());
     }
 
     /**
@@ -953,8 +2569,7 @@ class Propagator {
      * @return false
      */
     bool is_true(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_true(literal);
+        return m_lit_values[literal] > 0;
     }
 
     /**
@@ -966,8 +2581,7 @@ class Propagator {
      * @return false
      */
     bool is_false(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_false(literal);
+        return m_lit_values[literal] < 0;
     }
 
     /**
@@ -979,8 +2593,7 @@ class Propagator {
      * @return false
      */
     bool is_open_or_true(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_open_or_true(literal);
+        return m_lit_values[literal] >= 0;
     }
 
     /**
@@ -992,16 +2605,15 @@ class Propagator {
      * @return false
      */
     bool is_open(Lit literal) const noexcept {
-        Var v = lit::var(literal);
-        return variables[v].is_open();
+        return m_lit_values[literal] == 0;
     }
 
     /**
      * @brief Get the list of literals that are currently assigned to true.
      *
-     * @return const std::vector<Lit>&
+     * @return const Vector<Lit>&
      */
-    const std::vector<Lit>& get_trail() const noexcept { 
+    const Vector<Lit>& get_trail() const noexcept { 
         return trail_lits; 
     }
 
@@ -1051,7 +2663,7 @@ class Propagator {
     /**
      * @brief Get the list of reasons for the literals that are currently assigned to true.
      */
-    const std::vector<Reason>&  get_reasons() const noexcept {
+    const Vector<Reason>&  get_reasons() const noexcept {
         return trail_reasons; 
     }
 
@@ -1073,15 +2685,17 @@ class Propagator {
 
     /**
      * @brief Get an iterator to the beginning of the current level in the trail.
+     * With chronological backtracking (see set_chronological_backtracking),
+     * the trail segment of a level may also contain assignments of lower levels.
      */
-    std::vector<Lit>::const_iterator current_level_begin() const noexcept {
+    Vector<Lit>::const_iterator current_level_begin() const noexcept {
         return trail_lits.begin() + levels.back().level_begin();
     }
 
     /**
      * @brief Get an iterator to the beginning of the current level in the trail reasons.
      */
-    std::vector<Reason>::const_iterator current_level_reasons_begin() const noexcept {
+    Vector<Reason>::const_iterator current_level_reasons_begin() const noexcept {
         return trail_reasons.begin() + levels.back().level_begin();
     }
 
@@ -1089,9 +2703,9 @@ class Propagator {
      * @brief Get an iterator to the beginning of the given level in the trail.
      *
      * @param level
-     * @return std::vector<Lit>::const_iterator
+     * @return Vector<Lit>::const_iterator
      */
-    std::vector<Lit>::const_iterator level_begin(std::uint32_t level) const {
+    Vector<Lit>::const_iterator level_begin(std::uint32_t level) const {
         return trail_lits.begin() + levels[level].level_begin();
     }
 
@@ -1099,9 +2713,9 @@ class Propagator {
      * @brief Get an iterator to the end of the given level in the trail.
      *
      * @param level
-     * @return std::vector<Lit>::const_iterator
+     * @return Vector<Lit>::const_iterator
      */
-    std::vector<Lit>::const_iterator level_end(std::uint32_t level) const {
+    Vector<Lit>::const_iterator level_end(std::uint32_t level) const {
         if (level >= levels.size() - 1)
             return trail_lits.end();
         return trail_lits.begin() + levels[level + 1].level_begin();
@@ -1128,13 +2742,13 @@ class Propagator {
      * Compute a list of [Level, Literal] pairs of decisions
      * that ultimately led to including l in the trail.
      */
-    inline const std::vector<std::pair<std::int32_t,Lit>> &decisions_leading_to(Lit l);
+    inline const Vector<std::pair<std::int32_t,Lit>> &decisions_leading_to(Lit l);
 
     /*
      * Compute a list of [Level, Literal] pairs of decisions
      * that ultimately led to the current conflict.
      */
-    inline const std::vector<std::pair<std::int32_t,Lit>>& decisions_leading_to_conflict();
+    inline const Vector<std::pair<std::int32_t,Lit>>& decisions_leading_to_conflict();
 
     // -------- PROPAGATION --------
     /**
@@ -1158,22 +2772,35 @@ class Propagator {
      */
     inline bool push_level(Lit decision);
 
+    /**
+     * @brief Push a sequence of assumptions, each as a decision on its own level,
+     * stopping at the first assumption that fails.
+     * Assumptions that are already true are skipped without creating a level.
+     * An assumption fails if it is already false (in which case the propagator
+     * is not conflicting and the assumption is not pushed) or if its
+     * propagation leads to a conflict (in which case is_conflicting() is true,
+     * as after push_level). Throws if the propagator is already conflicting.
+     *
+     * @return The index of the failed assumption, or assumptions.size()
+     *         if all assumptions hold.
+     */
+    inline std::size_t push_assumptions(std::span<const Lit> assumptions);
+
     /**
      * @brief Pop the highest decision level without learning.
      * There is no need for a conflict to use this method.
      * On conflict, it should be preferred to call resolve_conflicts instead,
      * but pop_level will also clear the conflict.
+     * With chronological backtracking, assignments of lower levels placed
+     * on the popped level are kept and propagated again; if the popped
+     * level was not the level of the conflict, the conflict may persist.
      */
     inline void pop_level();
 
     /**
      * Reset propagator to level 0.
      */
-    void reset_to_zero() noexcept {
-        while(get_current_level() > 0) {
-            pop_level();
-        }
-    }
+    inline void reset_to_zero();
 
     /**
      * @brief Resolve a conflict by learning a clause and jumping back
@@ -1185,7 +2812,10 @@ class Propagator {
      *
      * In any case, all assignments on the current level are undone because
      * its decision led to a conflict; this is *NOT* reported to the given
-     * AssignmentHandler.
+     * AssignmentHandler. With chronological backtracking
+     * (see set_chronological_backtracking), assignments of lower levels are
+     * only undone if they are above the conflict level or the asserting
+     * literal is placed on the level directly below it.
      *
      * However, all assignments on lower levels that are undone or forced by
      * this action *ARE* reported. After learning a conflict clause and jumping
@@ -1221,6 +2851,120 @@ class Propagator {
         if(!resolve_conflicts()) throw UNSATException();
     }
 
+    // -------- LEARNT CLAUSE MANAGEMENT --------
+    /**
+     * @brief Get the number of learnt clauses of length > 2
+     *        that are currently in the clause database.
+     */
+    std::size_t num_learnt_clauses() const noexcept {
+        return m_num_learnt;
+    }
+
+    /**
+     * @brief Delete the weaker half of the learnt clauses of length > 2.
+     * Learnt clauses are scored by recent use in conflict analysis,
+     * their LBD (literal block distance) and their activity;
+     * clauses with LBD <= 2, clauses of length 3 (whose reasons do not
+     * refer to them, so their use is not tracked) and clauses that are
+     * currently the reason for an assignment are never deleted.
+     * Afterwards, the clause database is compacted;
+     * this invalidates all ClauseRefs to learnt clauses held outside
+     * of the propagator (including copies of Reasons).
+     */
+    inline void reduce_learnts();
+
+    /**
+     * @brief Automatically call reduce_learnts() from resolve_conflicts()
+     * whenever the given number of clauses of length > 2 have been
+     * learnt since the last reduction. 0 (the default) disables
+     * automatic reduction.
+     */
+    void set_learnt_reduction_interval(std::size_t interval) noexcept {
+        m_reduction_interval = interval;
+    }
+
+    /**
+     * @brief Restore the locality of the watch lists, which are stored
+     * in a single slab, by laying them out contiguously in literal order;
+     * also releases the blocks freed by growing watch lists.
+     * Useful after heavy conflict learning or after reduce_learnts().
+     */
+    void compact_watches() {
+        watchers.compact();
+    }
+
+    // -------- TUNING --------
+    /**
+     * @brief Set the number k of watchers ahead of the current one for
+     * which propagation through longer clauses issues prefetches:
+     * for the watch slot or learnt clause of the watcher k positions ahead,
+     * and for the blocker value and original clause literals of the
+     * watcher k/2 positions ahead; also prefetches the watch list of the
+     * next literal to propagate. 0 (the default) disables prefetching.
+     * Helps on formulas that do not fit into the last-level cache
+     * (values between 4 and 8 work well); costs time on smaller formulas.
+     */
+    void set_prefetch_lookahead(std::uint32_t lookahead) noexcept {
+        m_prefetch_lookahead = lookahead;
+    }
+
+    /**
+     * @brief Get the prefetch lookahead (see set_prefetch_lookahead).
+     */
+    std::uint32_t get_prefetch_lookahead() const noexcept {
+        return m_prefetch_lookahead;
+    }
+
+    /**
+     * @brief Enable or disable binary-first propagation.
+     * By default, each literal on the trail is propagated through the binary
+     * clauses and then through the longer clauses before the next literal.
+     * In binary-first mode, propagation keeps two positions on the trail and
+     * exhausts all binary implications before visiting the clauses of length > 2
+     * of the next literal, so that conflicts among binary clauses are found
+     * without touching the clause database. This changes the order of the trail,
+     * but not the set of assigned literals or whether a conflict is found.
+     * Has no effect with SPROP_INLINE_BINARY_WATCHERS.
+     */
+    void set_binary_first_propagation(bool binary_first) noexcept {
+        m_binary_first = binary_first;
+        m_binary_queue_head = trail_queue_head;
+    }
+
+    /**
+     * @brief Check whether binary-first propagation is enabled (see set_binary_first_propagation).
+     */
+    bool get_binary_first_propagation() const noexcept {
+        return m_binary_first;
+    }
+
+    /**
+     * @brief Use chronological backtracking in resolve_conflicts when jumping
+     * back to the asserting level would undo more than max_jump levels.
+     * In that case, only the conflict level is undone, and the asserting
+     * literal of the learnt clause is assigned out of order, on the highest level
+     * among the other literals of the clause; the assignments on the levels in
+     * between are kept instead of being propagated again. The trail is then no
+     * longer sorted by level, and conflicts may occur below the current level;
+     * resolve_conflicts first backtracks to the level of the conflict.
+     * The default (always_backjump) disables chronological backtracking.
+     */
+    void set_chronological_backtracking(std::uint32_t max_jump) noexcept {
+        m_chrono_max_jump = max_jump;
+    }
+
+    /**
+     * @brief Get the maximum backjump distance (see set_chronological_backtracking).
+     */
+    std::uint32_t get_chronological_backtracking() const noexcept {
+        return m_chrono_max_jump;
+    }
+
+    /**
+     * @brief The value of set_chronological_backtracking that disables it.
+     */
+    static constexpr std::uint32_t always_backjump = (std::numeric_limits<std::uint32_t>::max)();
+
     // -------- RESULT EXTRACTION --------
     /**
      * @brief Extract an assignment as bit-vector, where result[i] == true means
@@ -1228,28 +2972,83 @@ class Propagator {
      */
     inline std::vector<bool> extract_assignment() const;
 
+    // -------- MEMORY USAGE --------
+    /**
+     * @brief Breakdown of the memory used by a propagator.
+     */
+    struct MemoryBreakdown {
+        // The original clauses (long and binary); 
+        // shared by all copies of a propagator.
+        MemoryUsage original_clauses;
+        // The arena of learnt clauses of length > 2.
+        MemoryUsage learnt_clauses;
+        // The watch lists (including the watched literals of original clauses).
+        MemoryUsage watch_lists;
+        // The learnt binary clauses.
+        MemoryUsage binary_clauses;
+        // The trail literals, reasons and level information.
+        MemoryUsage trail;
+        // The variable states.
+        MemoryUsage variables;
+        // Unary clauses and auxiliary buffers.
+        MemoryUsage buffers;
+
+        /**
+         * @brief The total memory used by the propagator,
+         *        excluding the shared original clauses.
+         */
+        MemoryUsage total_unshared() const noexcept {
+            return learnt_clauses + watch_lists + binary_clauses + 
+                   trail + variables + buffers;
+        }
+
+        MemoryUsage total() const noexcept {
+            return original_clauses + total_unshared();
+        }
+    };
+
+    /**
+     * @brief Get the memory currently used by the propagator.
+     */
+    inline MemoryBreakdown memory_usage() const noexcept;
+
   private:
     // -------- FORMULA DATA --------
-    std::vector<Lit> m_unary_clauses;
-    std::vector<std::vector<Lit>> m_binary_clauses;
-    std::vector<Lit> m_large_clause_db;
+    // The original binary and long clauses, shared by all copies.
+    std::shared_ptr<const OriginalFormula> m_original;
+    Vector<Lit> m_unary_clauses;
+    // The learnt binary clauses.
+    BasicBinaryClauseStore<LitAllocator> m_binary_clauses;
+    // Learnt clauses of length > 2, in the same format as the original
+    // clauses; the clause with ClauseRef c begins at c - m_learnt_begin + 2.
+    // Clauses with a saved search position are followed by that position.
+    detail::ClauseArena<LitAllocator> m_learnt_clause_db;
+    // The watch slots of the original clauses of length > 3.
+    Vector<OriginalWatch> m_original_watches;
     Var m_num_vars;
 
     // -------- VARIABLE/LITERAL STATE --------
     // The state of our variables.
-    std::vector<VariableState> variables;
+    Vector<VariableState> variables;
+    // The value of each literal (1: true, 0: open, -1: false),
+    // kept in sync with variables for fast checks during propagation;
+    // padded for the vectorized replacement search.
+    Vector<std::int8_t> m_lit_values;
     // For each literal, a list of watchers.
-    std::vector<WatchList> watchers;
+    WatchStore watchers;
 
     // -------- TRAIL --------
     // The literals on the trail.
-    std::vector<Lit> trail_lits;
+    Vector<Lit> trail_lits;
     // The reasons on the trail.
-    std::vector<Reason> trail_reasons;
+    Vector<Reason> trail_reasons;
     // The levels of the trail.
-    std::vector<LevelInfo> levels;
+    Vector<LevelInfo> levels;
     // The index of the next literal to propagate on.
     std::size_t trail_queue_head{0};
+    // In binary-first mode, the index of the next literal to propagate
+    // on through binary clauses (trail_queue_head <= m_binary_queue_head).
+    std::size_t m_binary_queue_head{0};
 
     // -------- CONFLICT INFORMATION --------
     // The reason for the current conflict.
@@ -1265,20 +3064,84 @@ class Propagator {
 
     // -------- AUXILIARY BUFFERS --------
     // Buffer for building a learnt clause
-    std::vector<Lit> learn_buffer;
+    Vector<Lit> learn_buffer;
     // Buffer for supporting decisions of a literal.
-    std::vector<std::pair<std::int32_t,Lit>> supporting_decision_buffer;
+    Vector<std::pair<std::int32_t,Lit>> supporting_decision_buffer;
+
+    // -------- LEARNT CLAUSE INFORMATION --------
+    // The ClauseRef of the first learnt clause of length > 2;
+    // all clauses before it are original clauses (in m_original).
+    ClauseRef m_learnt_begin{2};
+    // The number of learnt clauses of length > 2.
+    std::size_t m_num_learnt{0};
+    // The number of learnt clauses between automatic reductions (0: never).
+    std::size_t m_reduction_interval{0};
+    // The number of clauses learnt since the last reduction.
+    std::size_t m_learnts_since_reduction{0};
+
+    // -------- TUNING --------
+    // The number of watchers to prefetch ahead (0: no prefetching).
+    std::uint32_t m_prefetch_lookahead{SPROP_DEFAULT_PREFETCH_LOOKAHEAD};
+    // Whether all binary implications are propagated before longer clauses.
+    bool m_binary_first{false};
+    // Backjumps over more levels are replaced by chronological backtracking.
+    std::uint32_t m_chrono_max_jump{always_backjump};
 
 
     // ----------------- IMPLEMENTATION BEYOND THIS POINT -----------------
     /**
-     * @brief Get the literals of a clause longer than 2.
+     * @brief Get a pointer to the first literal of a clause longer than 2.
+     */
+    const Lit* p_clause_begin(ClauseRef clause) const noexcept {
+        if (clause < m_learnt_begin)
+            return m_original->clause_db.data() + clause;
+        return m_learnt_clause_db.data() + (clause - m_learnt_begin + 2);
+    }
+
+    /**
+     * @brief Get the literals of a learnt clause longer than 2.
      */
     MutClausePtrRange mut_lits_of(ClauseRef clause) noexcept {
-        Lit* begin = m_large_clause_db.data() + clause;
+        assert(clause >= m_learnt_begin);
+        Lit* begin = m_learnt_clause_db.data() + (clause - m_learnt_begin + 2);
         return std::ranges::subrange(begin, begin + begin[-1]);
     }
 
+    /**
+     * @brief Overwrite the metadata header of a learnt clause longer than 2.
+     */
+    void p_set_header(ClauseRef clause, ClauseHeader header) noexcept {
+        assert(clause >= m_learnt_begin);
+        m_learnt_clause_db[clause - m_learnt_begin] = header.raw();
+    }
+
+    /**
+     * @brief Check whether clauses of the given length keep a saved search position.
+     */
+    static constexpr bool p_has_saved_search(ClauseLen length) noexcept {
+        return length >= saved_search_min_length;
+    }
+
+    /**
+     * @brief Append a learnt clause with the given header to the clause database.
+     */
+    template<typename LitRange>
+    ClauseRef p_append_learnt_clause(ClauseHeader header, const LitRange& literals) {
+        ClauseRef ref = m_learnt_begin + ClauseRef(m_learnt_clause_db.size());
+        auto length = ClauseLen(std::ranges::size(literals));
+        if (NIL_CLAUSE - ref <= std::size_t(length) + 3) {
+            throw std::length_error("Learnt clauses exceed the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
+        }
+        m_learnt_clause_db.push_back(header.raw());
+        m_learnt_clause_db.push_back(length);
+        m_learnt_clause_db.insert(m_learnt_clause_db.end(), std::ranges::begin(literals), std::ranges::end(literals));
+        if (p_has_saved_search(length)) {
+            // the search for a replacement of the watched literals starts after them
+            m_learnt_clause_db.push_back(2);
+        }
+        return ref;
+    }
+
     /**
      * Assign the given literal to true at decision level 0.
      * Return false if this leads to a conflict.
@@ -1287,6 +3150,7 @@ class Propagator {
         VariableState& vstate = variables[lit::var(forced_true)];
         if (vstate.is_open()) {
             vstate.assign(trail_lits.size(), forced_true, 0);
+            p_set_true(forced_true);
             trail_lits.push_back(forced_true);
             trail_reasons.push_back(Reason::Unary{forced_true});
         } else {
@@ -1307,10 +3171,28 @@ class Propagator {
                      Lit literal, ReasonType&& reason) 
     {
         vstate.assign(trail_lits.size(), literal, level);
+        p_set_true(literal);
         trail_lits.push_back(literal);
         trail_reasons.emplace_back(std::forward<ReasonType>(reason));
     }
 
+    /**
+     * Set the value of the given literal to true (and its negation to false).
+     */
+    void p_set_true(Lit literal) noexcept {
+        m_lit_values[literal] = 1;
+        m_lit_values[lit::negate(literal)] = -1;
+    }
+
+    /**
+     * Make the variable of the given literal open.
+     */
+    void p_make_open(Lit literal) noexcept {
+        variables[lit::var(literal)].make_open();
+        m_lit_values[literal] = 0;
+        m_lit_values[lit::negate(literal)] = 0;
+    }
+
     /**
      * Initialize level 0 with the unary clauses.
      */
@@ -1344,11 +3226,10 @@ class Propagator {
      * Insert a new long clause into the watch lists,
      * unless it is satisfied, forcing or conflicting at level 0.
      */
-    void p_new_long_clause_on_construction(ClauseRef ref, MutClausePtrRange literals) {
-        Lit *new_first[2];
+    void p_new_long_clause_on_construction(ClauseRef ref, ClauseRef slot, ClausePtrRange literals) {
+        const Lit *new_first[2];
         std::int32_t nws = 0;
-        Lit* lit_array = literals.begin();
-        for(Lit* current = lit_array, *end = literals.end(); current != end; ++current) {
+        for(const Lit* current = literals.begin(), *end = literals.end(); current != end; ++current) {
             Lit l = *current;
             VariableState& vstate = variables[lit::var(l)];
             auto s = vstate.state(l);
@@ -1368,7 +3249,7 @@ class Propagator {
         if(nws == 0) { 
             // violated at level 0 - conflict, UNSAT
             conflicting = true;
-            conflict_reason = Reason::Clause{ClauseLen(literals.size()), ref};
+            conflict_reason = p_clause_reason(ref);
             return;
         }
         if(nws == 1) {
@@ -1378,13 +3259,12 @@ class Propagator {
             p_assign_at_0(forced_true);
             return;
         }
-        // move the watched literals to the front
-        std::swap(*new_first[0], lit_array[0]);
-        std::swap(*new_first[1], lit_array[1]);
+        // remember the watched literals (the clause itself is immutable)
+        Lit w1 = *new_first[0], w2 = *new_first[1];
+        m_original_watches[slot] = OriginalWatch{{w1, w2}, ref, 0};
         // install watchers
-        Lit w1 = lit_array[0], w2 = lit_array[1];
-        watchers[w1].push_back(Watcher{w2, ref});
-        watchers[w2].push_back(Watcher{w1, ref});
+        watchers.push_back(w1, Watcher{w2, slot});
+        watchers.push_back(w2, Watcher{w1, slot});
     }
 
     /**
@@ -1394,69 +3274,117 @@ class Propagator {
         p_init_unaries();
         if(conflicting) return;
         watchers.resize(2 * m_num_vars);
-        for(ClauseRef ref = first_longer_clause(); ref < longer_clause_end(); ref = next_clause(ref)) {
-            MutClausePtrRange literals = mut_lits_of(ref);
-            p_new_long_clause_on_construction(ref, literals);
+        m_original_watches.assign(m_original->num_clauses - m_original->num_ternary_clauses, 
+                                  OriginalWatch{{NIL, NIL}, NIL_CLAUSE, 0});
+        ClauseRef next_slot = 0;
+        for(ClauseRef ref = first_longer_clause(); ref < m_learnt_begin; ref = next_clause(ref)) {
+            ClausePtrRange literals = lits_of(ref);
+            // clauses of length 3 are propagated through the occurrence lists
+            // (which also handles them at level 0, during the initial propagation)
+            if(literals.size() == 3) continue;
+            p_new_long_clause_on_construction(ref, next_slot++, literals);
             if(conflicting) return;
         }
         p_init_binary_watches();
     }
 
     /**
-     * Process the short clauses.
+     * Set up the storage for learnt binary clauses; with 
+     * SPROP_INLINE_BINARY_WATCHERS, also import the original binary
+     * clauses into the watch lists.
      */
-    void p_process_short_clauses() {
-        for(auto& list : m_binary_clauses) {
-            std::sort(list.begin(), list.end());
-            list.erase(std::unique(list.begin(), list.end()), list.end());
+    void p_import_binary_clauses(const std::vector<std::vector<Lit>>& partner_lists) {
+        if constexpr (inline_binary_watchers) {
+            watchers.resize(2 * m_num_vars);
+            std::vector<Lit> partners;
+            for (Lit l = 0; l < partner_lists.size(); ++l) {
+                partners = partner_lists[l];
+                std::sort(partners.begin(), partners.end());
+                partners.erase(std::unique(partners.begin(), partners.end()), partners.end());
+                for (Lit p : partners) {
+                    watchers.push_back(l, Watcher{p, Watcher::binary_tag});
+                }
+            }
+        } else {
+            m_binary_clauses.build({}, 2 * m_num_vars);
         }
-        m_binary_clauses.resize(m_num_vars * 2);
     }
 
     /**
-     * Import the longer clauses.
+     * Create the shared original formula from the given model.
      */
-    void p_import_large_clauses(const std::vector<std::vector<Lit>>& clauses) {
+    static std::shared_ptr<const OriginalFormula> 
+        p_make_original_formula(const ModelBuilder& model, const Allocator& alloc) 
+    {
+        LitAllocator lit_alloc(alloc);
+        auto formula = std::allocate_shared<OriginalFormula>(lit_alloc, lit_alloc);
+        formula->binary_clauses.build(model.m_binary_clauses, lit::absolute(model.m_current_lit));
+        formula->ternary_clauses.build(model.m_longer_clauses, lit::absolute(model.m_current_lit));
         std::size_t total_size = 0;
-        for(const auto& clause : clauses) {
-            total_size += clause.size() + 1;
+        for(const auto& clause : model.m_longer_clauses) {
+            total_size += clause.size() + 2;
+        }
+        if (model.m_longer_clauses.size() > (NIL >> 1) || 
+            total_size >= std::size_t(NIL_CLAUSE) - 2) 
+        {
+            throw std::length_error("Too many clauses for the configured index widths (see SPROP_CLAUSE_REF_BITS)!");
         }
-        m_large_clause_db.reserve(std::size_t(std::round(total_size * 1.5)));
-        for(const auto& clause : clauses) {
-            m_large_clause_db.push_back(ClauseLen(clause.size()));
-            m_large_clause_db.insert(m_large_clause_db.end(), clause.begin(), clause.end());
+        auto& db = formula->clause_db;
+        db.reserve(total_size);
+        for(const auto& clause : model.m_longer_clauses) {
+            formula->num_ternary_clauses += (clause.size() == 3);
+            db.push_back(ClauseHeader::original(std::uint32_t(formula->num_clauses++)).raw());
+            db.push_back(ClauseLen(clause.size()));
+            db.insert(db.end(), clause.begin(), clause.end());
         }
+        return formula;
     }
 
     /**
-     * Roll back the current decision level; if report is set,
-     * report undone assignments to the given handler.
+     * Roll back all decision levels above the target level.
+     * Undone assignments at trail positions below known_end are reported
+     * to the handler (in reverse trail order). After chronological
+     * backtracking, the rolled-back part of the trail may contain assignments
+     * of levels <= target; these are kept, moved down in trail order and
+     * queued for propagation again, as their consequences on the rolled-back
+     * levels are undone. known_end is updated to the end of the assignments
+     * that remain known to the handler.
      */
     template <typename AssignmentHandler>
-    void p_rollback_level(AssignmentHandler& handler, bool report) {
-        if (levels.back().level_begin() == 0) {
-            for (auto i = trail_lits.rbegin(), e = trail_lits.rend(); i != e; ++i) {
-                Lit l = *i;
-                if (report)
-                    handler.assignment_undone(l);
-                variables[lit::var(l)].make_open();
+    void p_rollback_level(AssignmentHandler& handler, std::int32_t target, std::size_t& known_end) {
+        const std::size_t begin = levels[target + 1].level_begin();
+        bool kept = false;
+        for (std::size_t i = trail_lits.size(); i-- > begin;) {
+            Lit l = trail_lits[i];
+            if (variables[lit::var(l)].level() <= target) {
+                kept = true;
+                continue;
             }
-            trail_lits.clear();
-            trail_reasons.clear();
-        } else {
-            auto current_end =
-                trail_lits.begin() + (levels.back().level_begin() - 1);
-            auto current_begin = trail_lits.end() - 1;
-            for (; current_begin != current_end; --current_begin) {
-                trail_reasons.pop_back();
-                Lit l = *current_begin;
-                if (report)
-                    handler.assignment_undone(l);
-                variables[lit::var(l)].make_open();
+            if (i < known_end)
+                handler.assignment_undone(l);
+            p_make_open(l);
+        }
+        std::size_t out = begin;
+        std::size_t new_known_end = (std::min)(known_end, begin);
+        if (kept) {
+            for (std::size_t i = begin, e = trail_lits.size(); i != e; ++i) {
+                Lit l = trail_lits[i];
+                VariableState& vs = variables[lit::var(l)];
+                if (vs.is_open())
+                    continue;
+                vs.assign(TrailLen(out), l, vs.level());
+                trail_lits[out] = l;
+                trail_reasons[out] = trail_reasons[i];
+                ++out;
+                new_known_end += (i < known_end);
             }
-            trail_lits.erase(current_end + 1, trail_lits.end());
         }
-        levels.pop_back();
+        trail_lits.erase(trail_lits.begin() + out, trail_lits.end());
+        trail_reasons.erase(trail_reasons.begin() + out, trail_reasons.end());
+        levels.erase(levels.begin() + (target + 1), levels.end());
+        known_end = new_known_end;
+        trail_queue_head = (std::min)(trail_queue_head, begin);
+        m_binary_queue_head = (std::min)(m_binary_queue_head, begin);
     }
 
     /**
@@ -1473,12 +3401,11 @@ class Propagator {
      * Return false on conflict.
      */
     bool p_propagate_binary(Lit lfalse, Lit other, std::int32_t level) {
-        Lit v = lit::var(other);
-        VariableState& vs = variables[v];
-        if (vs.is_open()) {
-            p_assign_at(vs, level, other, Reason::Binary{lfalse, other});
+        std::int8_t value = m_lit_values[other];
+        if (value == 0) {
+            p_assign_at(variables[lit::var(other)], level, other, Reason::Binary{lfalse, other});
         } else {
-            if (vs.is_false(other)) {
+            if (value < 0) {
                 conflicting = true;
                 conflict_reason = Reason::Binary{lfalse, other};
                 conflict_lit = other;
@@ -1492,28 +3419,176 @@ class Propagator {
      * Propagate a new decision or consequence through binary clauses.
      */
     bool p_propagate_through_binaries(Lit ltrue) {
+        if constexpr (inline_binary_watchers) {
+            // handled in p_propagate_through_longer
+            return true;
+        }
         Lit lfalse = lit::negate(ltrue);
         auto level = std::int32_t(levels.size() - 1);
-        for (Lit other : binary_partners_of(lfalse)) {
+        for (Lit other : m_original->binary_clauses.csr_partners_of(lfalse)) {
+            if(!p_propagate_binary(lfalse, other, level))
+                return false;
+        }
+        for (Lit other : m_binary_clauses.csr_partners_of(lfalse)) {
             if(!p_propagate_binary(lfalse, other, level))
                 return false;
         }
+        return m_binary_clauses.all_overflow_partners_of(lfalse, [&] (Lit other) {
+            return p_propagate_binary(lfalse, other, level);
+        });
+    }
+
+    /**
+     * Propagate a new decision or consequence through the
+     * original clauses of length 3, using their occurrence lists.
+     */
+    bool p_propagate_through_ternaries(Lit ltrue) {
+        Lit lfalse = lit::negate(ltrue);
+        auto level = std::int32_t(levels.size() - 1);
+        const std::int8_t* values = m_lit_values.data();
+        for (const auto& [a, b] : m_original->ternary_clauses.occurrences_of(lfalse)) {
+            std::int8_t va = values[a], vb = values[b];
+            if (va > 0 || vb > 0 || (va == 0 && vb == 0))
+                continue;
+            if (va < 0 && vb < 0) {
+                conflicting = true;
+                conflict_lit = a;
+                conflict_reason = Reason::Ternary{a, lfalse, b};
+                return false;
+            }
+            Lit forced = va == 0 ? a : b;
+            Lit other = va == 0 ? b : a;
+            p_assign_at(variables[lit::var(forced)], level, forced, Reason::Ternary{forced, lfalse, other});
+        }
         return true;
     }
 
     /**
-     * Check if *watcher_in has a true blocker.
-     * In that case, copy it to *watcher_out and advance both.
+     * Check if ws[watcher_in] has a true blocker.
+     * In that case, copy it to ws[watcher_out] and advance both.
      * Otherwise, simply return false.
      */
-    bool p_has_true_blocker(WatchIter& watcher_in, WatchIter& watcher_out) {
-        if (is_true(watcher_in->blocker)) {
-            *watcher_out++ = *watcher_in++;
+    bool p_has_true_blocker(Watcher* ws, std::size_t& watcher_in, std::size_t& watcher_out) {
+        if (is_true(ws[watcher_in].blocker)) {
+            ws[watcher_out++] = ws[watcher_in++];
             return true;
         }
         return false;
     }
 
+    /**
+     * Prefetch the memory needed to process the given watcher
+     * (its watch slot or learnt clause) if its blocker is not true.
+     */
+    void p_prefetch_watcher(const Watcher& w) const noexcept {
+        if (w.clause < m_learnt_begin) {
+            SPROP_PREFETCH(&m_original_watches[w.clause]);
+        } else if (!w.is_binary()) {
+            SPROP_PREFETCH(p_clause_begin(w.clause) - 2);
+        }
+    }
+
+    /**
+     * Second prefetch stage for a watcher, after the first stage
+     * had time to bring in its watch slot: prefetch the blocker value
+     * and, for original clauses, the literals at the position
+     * where the next replacement search starts.
+     */
+    void p_prefetch_clause(const Watcher& w) const noexcept {
+        SPROP_PREFETCH(&m_lit_values[w.blocker]);
+        if (w.clause >= m_learnt_begin)
+            return;
+        const OriginalWatch& slot = m_original_watches[w.clause];
+        SPROP_PREFETCH(m_original->clause_db.data() + slot.clause + slot.search_pos);
+    }
+
+    /**
+     * For a clause in which lfalse is watched (given as the clause
+     * member of its watcher), get a pointer to the
+     * two watched literals, arranged such that lfalse is the second one.
+     * For learnt clauses, these are the first two literals of the clause;
+     * for original clauses, they are in the clause's watch slot.
+     */
+    Lit* p_watched_pair(ClauseRef watched_clause, Lit lfalse) noexcept {
+        Lit* pair = watched_clause < m_learnt_begin ? 
+            m_original_watches[watched_clause].watched.data() :
+            mut_lits_of(watched_clause).begin();
+        if (pair[0] == lfalse) {
+            std::swap(pair[0], pair[1]);
+        }
+        return pair;
+    }
+
+    /**
+     * Search the original clause with the given watch slot for an open or
+     * true literal that is not watched, to replace its false watched literal.
+     * The clause is immutable, so instead of moving literals, the search
+     * continues circularly from where the last replacement was found.
+     * On success, update the slot and return the replacement.
+     * Otherwise, return NIL.
+     */
+    Lit p_find_original_replacement(ClauseRef slot_index) {
+        OriginalWatch& slot = m_original_watches[slot_index];
+        // slot.watched[1] is false, so only the other watched literal must be skipped
+        Lit first = slot.watched[0];
+        const Lit* begin = p_clause_begin(slot.clause);
+        const Lit* end = begin + begin[-1];
+        const Lit* start = begin + slot.search_pos;
+        const std::int8_t* values = m_lit_values.data();
+        auto search = [&] (const Lit* from, const Lit* to) {
+            const Lit* r = LiteralSearch::find_non_false(from, to, values);
+            if (r != to && *r == first)
+                r = LiteralSearch::find_non_false(r + 1, to, values);
+            return r;
+        };
+        const Lit* replacement = search(start, end);
+        if (replacement == end) {
+            replacement = search(begin, start);
+            if (replacement == start)
+                return NIL;
+        }
+        slot.search_pos = Lit(replacement - begin);
+        slot.watched[1] = *replacement;
+        return *replacement;
+    }
+
+    /**
+     * Search the given learnt clause for an open or true literal that
+     * is not watched, to replace the false watched literal pair[1];
+     * on success, move it to pair[1] and return it.
+     * Otherwise, return NIL.
+     * For clauses with a saved search position, the search continues
+     * circularly from the position of the last replacement (where the
+     * false literal it replaced now is), and that position is updated.
+     */
+    Lit p_find_learnt_replacement(Lit* pair) {
+        // search the rest of the clause for an open or true literal
+        ClauseLen length = pair[-1];
+        Lit* lit_end = pair + length;
+        const std::int8_t* values = m_lit_values.data();
+        Lit* replacement;
+        if (!p_has_saved_search(length)) {
+            replacement = LiteralSearch::find_non_false(pair + 2, lit_end, values);
+            if (replacement == lit_end)
+                return NIL;
+        } else {
+            Lit& search_pos = *lit_end;
+            Lit* start = pair + search_pos;
+            replacement = LiteralSearch::find_non_false(start, lit_end, values);
+            if (replacement == lit_end) {
+                replacement = LiteralSearch::find_non_false(pair + 2, start, values);
+                if (replacement == start)
+                    return NIL;
+            }
+            search_pos = Lit(replacement - pair);
+        }
+        // move it to pair[1]
+        Lit repl = *replacement;
+        *replacement = pair[1];
+        pair[1] = repl;
+        return repl;
+    }
+
     /**
      * Propagate a new decision or consequence through longer clauses.
      * Return false on conflict.
@@ -1528,68 +3603,123 @@ class Propagator {
     bool p_propagate_through_longer(Lit ltrue) {
         Lit lfalse = lit::negate(ltrue);
         auto level = std::int32_t(levels.size() - 1);
-        WatchList& ws = watchers[lfalse];
-        WatchIter watcher_in = ws.begin();
-        WatchIter watcher_out = ws.begin(); 
-        WatchIter watcher_end = ws.end();
+        // installing new watchers may move the watch slab,
+        // so we keep indices into the watch list of lfalse
+        Watcher* ws = watchers.data(lfalse);
+        std::size_t watcher_in = 0;
+        std::size_t watcher_out = 0;
+        std::size_t watcher_end = watchers.size(lfalse);
+        const std::size_t lookahead = m_prefetch_lookahead;
+        const std::size_t half_lookahead = lookahead / 2;
+        if(lookahead && trail_queue_head < trail_lits.size()) {
+            // the watch list of the next literal to be propagated
+            SPROP_PREFETCH(watchers.data(lit::negate(trail_lits[trail_queue_head])));
+        }
 
         // the main loop is essentially a big std::remove_if cleaning
         // up the watchers list 
         // but needs more guarantees than that std::algorithm provides
         while(watcher_in != watcher_end) {
-            if(p_has_true_blocker(watcher_in, watcher_out)) continue;
-            ClauseRef clause = watcher_in->clause;
-            MutClausePtrRange lits = mut_lits_of(clause);
-            Lit* lit_array = lits.begin();
-            Lit* lit_end = lits.end();
-            if(lit_array[0] == lfalse) {
-                // make it so lfalse is in lit_array[1]
-                std::swap(lit_array[0], lit_array[1]);
+            if(lookahead) {
+                if(watcher_in + lookahead < watcher_end)
+                    p_prefetch_watcher(ws[watcher_in + lookahead]);
+                if(half_lookahead && watcher_in + half_lookahead < watcher_end)
+                    p_prefetch_clause(ws[watcher_in + half_lookahead]);
+            }
+            if(p_has_true_blocker(ws, watcher_in, watcher_out)) continue;
+            if constexpr (inline_binary_watchers) {
+                if(ws[watcher_in].is_binary()) {
+                    Lit other = ws[watcher_in].blocker;
+                    ws[watcher_out++] = ws[watcher_in++];
+                    if(!p_propagate_binary(lfalse, other, level)) {
+                        std::copy(ws + watcher_in, ws + watcher_end, ws + watcher_out);
+                        watcher_out += watcher_end - watcher_in;
+                        break;
+                    }
+                    continue;
+                }
             }
+            ClauseRef watched_clause = ws[watcher_in].clause;
+            // make it so lfalse is in watched[1]
+            Lit* watched = p_watched_pair(watched_clause, lfalse);
             // check the other watched literal (if it is not the blocker) as new blocker;
             // also unconditionally advance watcher_in
-            Lit first = lit_array[0];
-            Watcher new_watcher{first, clause};
-            VariableState& first_state = variables[lit::var(first)];
-            if(first != watcher_in++->blocker && first_state.is_true(first)) {
-                *watcher_out++ = new_watcher;
+            Lit first = watched[0];
+            Watcher new_watcher{first, watched_clause};
+            if(first != ws[watcher_in++].blocker && is_true(first)) {
+                ws[watcher_out++] = new_watcher;
                 continue;
             }
-            // search the rest of the clause for an open or true literal
-            Lit* replacement = std::find_if(lit_array + 2, lit_end, [&] (Lit l) { return is_open_or_true(l); });
-            if(replacement != lit_end) {
-                // found replacement; move it to lit_array[1] and install new watcher;
+            bool original = watched_clause < m_learnt_begin;
+            Lit repl = original ? 
+                p_find_original_replacement(watched_clause) :
+                p_find_learnt_replacement(watched);
+            if(repl != NIL) {
+                // found replacement; install new watcher;
                 // do not advance watcher_out
-                Lit repl = *replacement;
-                lit_array[1] = repl;
-                *replacement = lfalse;
-                watchers[repl].push_back(new_watcher);
+                watchers.push_back(repl, new_watcher);
+                ws = watchers.data(lfalse);
             } else {
                 // clause is unit
-                *watcher_out++ = new_watcher;
-                Reason::Clause reason{ClauseLen(lits.size()), clause};
-                if(first_state.is_false(first)) {
+                ws[watcher_out++] = new_watcher;
+                ClauseRef clause = original ? m_original_watches[watched_clause].clause : watched_clause;
+                Reason reason = p_clause_reason(clause);
+                if(is_false(first)) {
                     // conflict
                     conflicting = true;
                     conflict_lit = first;
                     conflict_reason = reason;
-                    watcher_out = std::copy(watcher_in, watcher_end, watcher_out);
+                    std::copy(ws + watcher_in, ws + watcher_end, ws + watcher_out);
+                    watcher_out += watcher_end - watcher_in;
                     break;
                 } else {
-                    p_assign_at(first_state, level, first, reason);
+                    p_assign_at(variables[lit::var(first)], level, first, reason);
                 }
             }
         }
-        ws.erase(watcher_out, watcher_end);
+        watchers.truncate(lfalse, std::uint32_t(watcher_out));
         return !conflicting;
     }
 
     bool p_propagate(Lit ltrue) {
         if (!p_propagate_through_binaries(ltrue))
             return false;
+        if (!p_propagate_through_ternaries(ltrue))
+            return false;
         return p_propagate_through_longer(ltrue);
     }
 
+    /**
+     * Propagation in binary-first mode: before each literal is propagated
+     * through the clauses of length > 2, the binary clauses are propagated
+     * through for all literals on the trail.
+     */
+    bool p_propagate_binary_first() {
+        for (;;) {
+            while (m_binary_queue_head < trail_lits.size()) {
+                if (!p_propagate_through_binaries(trail_lits[m_binary_queue_head++]))
+                    return false;
+            }
+            if (trail_queue_head == trail_lits.size())
+                return true;
+            Lit prop = trail_lits[trail_queue_head++];
+            if (!p_propagate_through_ternaries(prop) || !p_propagate_through_longer(prop))
+                return false;
+        }
+    }
+
+    /**
+     * Get the reason for an assignment forced by the given clause of length > 2
+     * (self-contained for clauses of length 3).
+     */
+    Reason p_clause_reason(ClauseRef clause) const noexcept {
+        ClausePtrRange lits = lits_of(clause);
+        if (lits.size() == 3) {
+            return Reason::Ternary{lits[0], lits[1], lits[2]};
+        }
+        return Reason::Clause{ClauseLen(lits.size()), clause};
+    }
+
     std::uint32_t p_increase_stamp() noexcept {
         if (stamp_counter >= std::numeric_limits<std::uint32_t>::max() - 6) {
             for (VariableState& vs : variables) {
@@ -1661,9 +3791,124 @@ class Propagator {
     }
 
     std::uint32_t p_stamp_and_count(std::int32_t level, Reason reason) {
+        if (reason.is_clause_ref()) {
+            p_bump_learnt(reason.clause);
+        }
         return p_stamp_and_count(level, reason.lits(*this));
     }
 
+    /**
+     * Mark the given clause as used in conflict analysis
+     * (if it is a learnt clause).
+     */
+    void p_bump_learnt(ClauseRef clause) noexcept {
+        ClauseHeader header = header_of(clause);
+        if (header.is_learnt()) {
+            header.set_used(true);
+            header.bump_activity();
+            p_set_header(clause, header);
+        }
+    }
+
+    /**
+     * Compute the number of distinct decision levels
+     * of the literals in learn_buffer.
+     */
+    std::uint32_t p_compute_lbd() {
+        auto current = p_increase_stamp();
+        std::uint32_t lbd = 0;
+        for (Lit l : learn_buffer) {
+            LevelInfo& li = levels[variables[lit::var(l)].level()];
+            if (li.get_stamp() != current) {
+                li.stamp_with(current);
+                ++lbd;
+            }
+        }
+        return lbd;
+    }
+
+    /**
+     * Mark all learnt clauses that are currently
+     * the reason for an assignment or the conflict as locked.
+     */
+    void p_lock_reason_clauses() {
+        auto lock = [&] (const Reason& r) {
+            if (!r.is_clause_ref() || r.clause < m_learnt_begin)
+                return;
+            ClauseHeader header = header_of(r.clause);
+            header.set_locked(true);
+            p_set_header(r.clause, header);
+        };
+        std::for_each(trail_reasons.begin(), trail_reasons.end(), lock);
+        if (conflicting)
+            lock(conflict_reason);
+    }
+
+    /**
+     * Remove the learnt clauses marked as garbage from the clause database,
+     * move the remaining learnt clauses to close the gaps,
+     * and update all ClauseRefs in watchers and reasons.
+     */
+    void p_compact_learnts() {
+        std::vector<ClauseRef> old_refs;
+        std::vector<ClauseRef> new_refs;
+        old_refs.reserve(m_num_learnt);
+        new_refs.reserve(m_num_learnt);
+        ClauseRef out = m_learnt_begin;
+        ClauseRef end = longer_clause_end();
+        m_num_learnt = 0;
+        for (ClauseRef in = m_learnt_begin; in != end;) {
+            ClauseHeader header = header_of(in);
+            ClauseRef next = next_clause(in);
+            old_refs.push_back(in);
+            if (header.is_garbage()) {
+                new_refs.push_back(NIL_CLAUSE);
+                in = next;
+                continue;
+            }
+            header.set_used(false);
+            header.set_locked(false);
+            header.decay_activity();
+            p_set_header(in, header);
+            auto db_begin = m_learnt_clause_db.begin();
+            std::copy(db_begin + (in - m_learnt_begin), db_begin + (next - m_learnt_begin), 
+                      db_begin + (out - m_learnt_begin));
+            new_refs.push_back(out);
+            ++m_num_learnt;
+            out += next - in;
+            in = next;
+        }
+        m_learnt_clause_db.resize(out - m_learnt_begin);
+        auto remap = [&] (ClauseRef c) -> ClauseRef {
+            if (c < m_learnt_begin)
+                return c;
+            auto pos = std::lower_bound(old_refs.begin(), old_refs.end(), c);
+            return new_refs[pos - old_refs.begin()];
+        };
+        for (std::size_t l = 0, nl = watchers.num_lists(); l < nl; ++l) {
+            std::uint32_t watcher_out = 0;
+            std::span<Watcher> ws = watchers[l];
+            for (const Watcher& w : ws) {
+                if (w.is_binary()) {
+                    ws[watcher_out++] = w;
+                    continue;
+                }
+                ClauseRef c = remap(w.clause);
+                if (c != NIL_CLAUSE) {
+                    ws[watcher_out++] = Watcher{w.blocker, c};
+                }
+            }
+            watchers.truncate(l, watcher_out);
+        }
+        for (Reason& r : trail_reasons) {
+            if (r.is_clause_ref())
+                r.clause = remap(r.clause);
+        }
+        if (conflict_reason.is_clause_ref()) {
+            conflict_reason.clause = remap(conflict_reason.clause);
+        }
+    }
+
     /**
      * Check if the given literal is redundant in the current conflict clause.
      */
@@ -1725,9 +3970,24 @@ class Propagator {
                            learn_buffer.end());
     }
 
+    /**
+     * Get the highest level of a literal in the conflict clause.
+     * Without chronological backtracking, this is the current level.
+     */
+    std::int32_t p_conflict_level() {
+        std::int32_t level = 0;
+        for (Lit l : conflict_reason.lits(*this)) {
+            level = (std::max)(level, variables[lit::var(l)].level());
+        }
+        return level;
+    }
+
     /**
      * Compute and reduce a conflict clause;
      * it will be stored in learn_buffer.
+     * The conflict must be on the current level; as the trail
+     * may contain lower-level assignments after chronological
+     * backtracking, only literals on that level are resolved.
      */
     void p_compute_conflict_clause() {
         p_increase_stamp();
@@ -1739,7 +3999,7 @@ class Propagator {
         while (on_current_level > 1) {
             Lit l = *trail_lit_iter;
             Lit v = lit::var(l);
-            if (variables[v].get_stamp() >= stamp_counter) {
+            if (variables[v].get_stamp() >= stamp_counter && variables[v].level() == level) {
                 on_current_level +=
                     p_stamp_and_count(level, *trail_reason_iter);
                 --on_current_level;
@@ -1750,7 +4010,7 @@ class Propagator {
         for (;;) {
             Lit l = *trail_lit_iter;
             Lit v = lit::var(l);
-            if (variables[v].get_stamp() >= stamp_counter)
+            if (variables[v].get_stamp() >= stamp_counter && variables[v].level() == level)
                 break;
             --trail_lit_iter;
             --trail_reason_iter;
@@ -1779,17 +4039,16 @@ class Propagator {
     }
 
     /**
-     * Handle jumping back to the target level.
+     * Handle jumping back to the target level, or only one level
+     * down if chronological backtracking applies.
      */
     template <typename AssignmentHandler>
-    std::pair<std::int32_t, Lit> p_jumpback_to_target(AssignmentHandler& handler) 
+    std::pair<std::int32_t, Lit> p_jumpback_to_target(AssignmentHandler& handler, std::size_t& known_end)
     {
         auto [tlvl, tlit] = p_target_level();
-        p_rollback_level(handler, false);
-        while (levels.size() > std::size_t(tlvl + 1)) {
-            p_rollback_level(handler, true);
-        }
-        trail_queue_head = trail_lits.size();
+        std::int32_t clvl = get_current_level();
+        std::int32_t back = std::uint32_t(clvl - tlvl) > m_chrono_max_jump ? clvl - 1 : tlvl;
+        p_rollback_level(handler, back, known_end);
         return {tlvl, tlit};
     }
 
@@ -1797,39 +4056,45 @@ class Propagator {
         switch(learn_buffer.size()) {
             case 1: {
                 m_unary_clauses.push_back(learn_buffer.front());
-                return NIL;
+                return NIL_CLAUSE;
             }
             case 2: {
                 Lit l1 = learn_buffer[0], l2 = learn_buffer[1];
-                m_binary_clauses[l1].push_back(l2);
-                m_binary_clauses[l2].push_back(l1);
-                return NIL;
+                if constexpr (inline_binary_watchers) {
+                    watchers.push_back(l1, Watcher{l2, Watcher::binary_tag});
+                    watchers.push_back(l2, Watcher{l1, Watcher::binary_tag});
+                    return NIL_CLAUSE;
+                }
+                m_binary_clauses.add(l1, l2);
+                if (m_binary_clauses.overflow_size() >= (std::max)(m_binary_clauses.csr_size(), std::size_t(1024))) {
+                    m_binary_clauses.merge_overflow();
+                }
+                return NIL_CLAUSE;
             }
             default: {
-                ClauseRef ref(m_large_clause_db.size() + 1);
-                m_large_clause_db.push_back(ClauseLen(learn_buffer.size()));
-                m_large_clause_db.insert(m_large_clause_db.end(), learn_buffer.begin(), learn_buffer.end());
-                return ref;
+                ++m_num_learnt;
+                ++m_learnts_since_reduction;
+                return p_append_learnt_clause(ClauseHeader::learnt(p_compute_lbd()), learn_buffer);
             }
         }
     }
 
     void p_new_watch(Lit learnt, Lit target_lit, ClauseRef clause) {
-        assert(clause != NIL);
+        assert(clause != NIL_CLAUSE);
         MutClausePtrRange lits = mut_lits_of(clause);
         Lit* lit_array = lits.begin();
         assert(lit_array[0] == learnt);
         auto other = std::find(lits.begin() + 1, lits.end(), target_lit);
         assert(other != lits.end());
         std::swap(lit_array[1], *other);
-        watchers[learnt].push_back(Watcher{target_lit, clause});
-        watchers[target_lit].push_back(Watcher{learnt, clause});
+        watchers.push_back(learnt, Watcher{target_lit, clause});
+        watchers.push_back(target_lit, Watcher{learnt, clause});
     }
 
     template <typename AssignmentHandler>
-    void p_handle_conflict_clause(AssignmentHandler& handler) {
+    void p_handle_conflict_clause(AssignmentHandler& handler, std::size_t& known_end) {
         ClauseRef cref_if_long = p_insert_conflict_clause();
-        auto [tlvl, tlit] = p_jumpback_to_target(handler);
+        auto [tlvl, tlit] = p_jumpback_to_target(handler, known_end);
         Lit learned = learn_buffer.front();
         Lit lv = lit::var(learned);
         std::uint32_t len = learn_buffer.size();
@@ -1840,6 +4105,11 @@ class Propagator {
         case 2:
             p_assign_at(variables[lv], tlvl, learned, Reason::Binary{learned, learn_buffer[1]});
             break;
+        case 3:
+            p_assign_at(variables[lv], tlvl, learned, 
+                        Reason::Ternary{learned, learn_buffer[1], learn_buffer[2]});
+            p_new_watch(learned, tlit, cref_if_long);
+            break;
         default: 
             p_assign_at(variables[lv], tlvl, learned, Reason::Clause{len, cref_if_long});
             p_new_watch(learned, tlit, cref_if_long);
@@ -1847,31 +4117,60 @@ class Propagator {
         }
         learn_buffer.clear();
     }
+
+    /**
+     * Resolve the current conflict and any conflicts following it;
+     * the assignments at trail positions below known_end are known to the handler.
+     */
+    template <typename AssignmentHandler>
+    bool p_resolve_conflicts(AssignmentHandler& assignments, std::size_t known_end);
 };
 
-Propagator::Propagator() :
-    m_num_vars(0),
-    levels{{LevelInfo{0}}}
+template<typename Allocator>
+BasicPropagator<Allocator>::BasicPropagator(const Allocator& alloc) :
+    BasicPropagator(ModelBuilder{}, alloc)
 {}
 
-Propagator::Propagator(const ModelBuilder& model) :
-    m_unary_clauses(model.m_unary_clauses),
-    m_binary_clauses(model.m_binary_clauses),
+template<typename Allocator>
+BasicPropagator<Allocator>::BasicPropagator(const ModelBuilder& model, const Allocator& alloc) :
+    m_original(p_make_original_formula(model, alloc)),
+    m_unary_clauses(model.m_unary_clauses.begin(), model.m_unary_clauses.end(), alloc),
+    m_binary_clauses(alloc),
+    m_learnt_clause_db(alloc),
+    m_original_watches(alloc),
     m_num_vars(model.m_current_lit / 2),
-    variables(m_num_vars),
-    levels{{LevelInfo{0}}}
+    variables(m_num_vars, alloc),
+    m_lit_values(LiteralSearch::padded_size(2 * std::size_t(m_num_vars)), std::int8_t(0), alloc),
+    watchers(alloc),
+    trail_lits(alloc),
+    trail_reasons(alloc),
+    levels({LevelInfo{0}}, alloc),
+    learn_buffer(alloc),
+    supporting_decision_buffer(alloc),
+    m_learnt_begin(ClauseRef(m_original->clause_db.size() + 2))
 {
-    p_process_short_clauses();
-    p_import_large_clauses(model.m_longer_clauses);
+    p_import_binary_clauses(model.m_binary_clauses);
     p_init_watches();
     if(!conflicting) {
         propagate();
     }
 }
 
-bool Propagator::propagate() {
+template<typename Allocator>
+BasicPropagator<Allocator>::BasicPropagator(const BasicPropagator& other, const Allocator& alloc) :
+    BasicPropagator(alloc)
+{
+    // copy assignment keeps our allocator (for allocators that
+    // do not propagate on copy assignment, such as std::pmr)
+    *this = other;
+}
+
+template<typename Allocator>
+bool BasicPropagator<Allocator>::propagate() {
     if (conflicting)
         return false;
+    if (!inline_binary_watchers && m_binary_first)
+        return p_propagate_binary_first();
     while (trail_queue_head < trail_lits.size()) {
         Lit prop = trail_lits[trail_queue_head++];
         if (!p_propagate(prop))
@@ -1880,7 +4179,8 @@ bool Propagator::propagate() {
     return true;
 }
 
-std::vector<Lit> Propagator::get_decisions() const {
+template<typename Allocator>
+std::vector<Lit> BasicPropagator<Allocator>::get_decisions() const {
     std::vector<Lit> result;
     result.reserve(levels.size() - 1);
     for (auto ilvl = levels.begin() + 1, iend = levels.end(); ilvl != iend;
@@ -1891,7 +4191,8 @@ std::vector<Lit> Propagator::get_decisions() const {
     return result;
 }
 
-bool Propagator::resolve_conflicts() {
+template<typename Allocator>
+bool BasicPropagator<Allocator>::resolve_conflicts() {
     struct TrivialAssignmentHandler {
         void assignment_undone(Lit) const noexcept {}
         void assignment_forced(Lit) const noexcept {}
@@ -1900,7 +4201,8 @@ bool Propagator::resolve_conflicts() {
     return resolve_conflicts(handler);
 }
 
-bool Propagator::push_level(Lit decision) {
+template<typename Allocator>
+bool BasicPropagator<Allocator>::push_level(Lit decision) {
     Lit dvar = lit::var(decision);
     VariableState& vstate = variables[dvar];
     if(conflicting) {
@@ -1918,7 +4220,30 @@ bool Propagator::push_level(Lit decision) {
     return propagate();
 }
 
-void Propagator::pop_level() {
+template<typename Allocator>
+std::size_t BasicPropagator<Allocator>::push_assumptions(std::span<const Lit> assumptions) {
+    if(conflicting) {
+        throw std::invalid_argument(
+            "The propagator is already conflicting!");
+    }
+    for (std::size_t i = 0, n = assumptions.size(); i < n; ++i) {
+        Lit assumption = assumptions[i];
+        std::int8_t value = m_lit_values[assumption];
+        if (value > 0)
+            continue;
+        if (value < 0)
+            return i;
+        auto new_level = std::int32_t(levels.size());
+        levels.emplace_back(TrailLen(trail_lits.size()));
+        p_assign_at(variables[lit::var(assumption)], new_level, assumption, Reason::Decision{});
+        if (!propagate())
+            return i;
+    }
+    return assumptions.size();
+}
+
+template<typename Allocator>
+void BasicPropagator<Allocator>::pop_level() {
     if (levels.size() == 1) {
         throw std::invalid_argument(
             "Trying to pop level from propagator at level 0!");
@@ -1926,13 +4251,31 @@ void Propagator::pop_level() {
     struct TrivialHandler {
         void assignment_undone(Lit) {}
     } handler;
-    p_rollback_level(handler, false);
-    trail_queue_head = trail_lits.size();
+    std::size_t known_end = 0;
+    p_rollback_level(handler, get_current_level() - 1, known_end);
     if (conflicting)
         p_reset_conflict();
+    if (trail_queue_head != trail_lits.size())
+        propagate();
+}
+
+template<typename Allocator>
+void BasicPropagator<Allocator>::reset_to_zero() {
+    if (get_current_level() > 0) {
+        struct TrivialHandler {
+            void assignment_undone(Lit) {}
+        } handler;
+        std::size_t known_end = 0;
+        p_rollback_level(handler, 0, known_end);
+        if (conflicting)
+            p_reset_conflict();
+        if (trail_queue_head != trail_lits.size())
+            propagate();
+    }
 }
 
-const std::vector<std::pair<std::int32_t,Lit>> &Propagator::decisions_leading_to(Lit l) {
+template<typename Allocator>
+auto BasicPropagator<Allocator>::decisions_leading_to(Lit l) -> const Vector<std::pair<std::int32_t,Lit>>& {
     if(conflicting) throw std::logic_error("decisions_leading_to called on propagator with conflict!");
     if(is_open(l)) throw std::logic_error("decisions_leading_to called with open literal!");
     supporting_decision_buffer.clear();
@@ -1954,7 +4297,8 @@ const std::vector<std::pair<std::int32_t,Lit>> &Propagator::decisions_leading_to
     return supporting_decision_buffer;
 }
 
-const std::vector<std::pair<std::int32_t,Lit>>& Propagator::decisions_leading_to_conflict() {
+template<typename Allocator>
+auto BasicPropagator<Allocator>::decisions_leading_to_conflict() -> const Vector<std::pair<std::int32_t,Lit>>& {
     if(!conflicting) 
         throw std::logic_error("decisions_leading_to_conflict called on non-conflicting propagator!");
 
@@ -1979,31 +4323,89 @@ const std::vector<std::pair<std::int32_t,Lit>>& Propagator::decisions_leading_to
     return supporting_decision_buffer;
 }
 
+template<typename Allocator>
 template <typename AssignmentHandler>
-bool Propagator::resolve_conflicts(AssignmentHandler& assignments) {
+bool BasicPropagator<Allocator>::resolve_conflicts(AssignmentHandler& assignments) {
     if (!conflicting)
         return true;
-    if (levels.size() == 1)
+    return p_resolve_conflicts(assignments, levels.back().level_begin());
+}
+
+template<typename Allocator>
+template <typename AssignmentHandler>
+bool BasicPropagator<Allocator>::p_resolve_conflicts(AssignmentHandler& assignments, std::size_t known_end) {
+    std::int32_t clvl = p_conflict_level();
+    if (clvl < get_current_level())
+        p_rollback_level(assignments, clvl, known_end);
+    if (clvl == 0)
         return false;
     p_compute_conflict_clause();
-    p_handle_conflict_clause(assignments);
+    p_handle_conflict_clause(assignments, known_end);
     p_reset_conflict();
-    std::size_t tsize = trail_queue_head;
-    std::size_t lbegin = levels.back().level_begin();
     if (!propagate()) {
-        for (std::size_t cpos = tsize - 1; cpos != lbegin - 1; --cpos) {
-            assignments.assignment_undone(trail_lits[cpos]);
-        }
-        return resolve_conflicts(assignments);
+        return p_resolve_conflicts(assignments, known_end);
     } else {
-        for (auto i = trail_lits.begin() + tsize, e = trail_lits.end(); i != e; ++i) {
+        for (auto i = trail_lits.begin() + known_end, e = trail_lits.end(); i != e; ++i) {
             assignments.assignment_forced(*i);
         }
+        if (m_reduction_interval != 0 && m_learnts_since_reduction >= m_reduction_interval) {
+            reduce_learnts();
+        }
         return true;
     }
 }
 
-std::vector<bool> Propagator::extract_assignment() const {
+template<typename Allocator>
+void BasicPropagator<Allocator>::reduce_learnts() {
+    m_learnts_since_reduction = 0;
+    if (m_num_learnt == 0)
+        return;
+    p_lock_reason_clauses();
+    std::vector<ClauseRef> candidates;
+    for (ClauseRef c = m_learnt_begin, e = longer_clause_end(); c != e; c = next_clause(c)) {
+        ClauseHeader header = header_of(c);
+        if (!header.is_locked() && header.lbd() > 2 && clause_length(c) > 3) {
+            candidates.push_back(c);
+        }
+    }
+    auto weaker = [&] (ClauseRef c1, ClauseRef c2) {
+        ClauseHeader h1 = header_of(c1), h2 = header_of(c2);
+        if (h1.is_used() != h2.is_used())
+            return !h1.is_used();
+        if (h1.lbd() != h2.lbd())
+            return h1.lbd() > h2.lbd();
+        return h1.activity() < h2.activity();
+    };
+    auto num_deleted = candidates.size() / 2;
+    std::nth_element(candidates.begin(), candidates.begin() + num_deleted, 
+                     candidates.end(), weaker);
+    for (std::size_t i = 0; i < num_deleted; ++i) {
+        ClauseHeader header = header_of(candidates[i]);
+        header.set_garbage(true);
+        p_set_header(candidates[i], header);
+    }
+    p_compact_learnts();
+}
+
+template<typename Allocator>
+auto BasicPropagator<Allocator>::memory_usage() const noexcept -> MemoryBreakdown {
+    MemoryBreakdown result;
+    result.original_clauses = memory_usage_of(m_original->clause_db) + 
+                              m_original->binary_clauses.memory_usage() +
+                              m_original->ternary_clauses.memory_usage();
+    result.learnt_clauses = memory_usage_of(m_learnt_clause_db);
+    result.watch_lists = watchers.memory_usage() + memory_usage_of(m_original_watches);
+    result.binary_clauses = m_binary_clauses.memory_usage();
+    result.trail = memory_usage_of(trail_lits) + memory_usage_of(trail_reasons) + 
+                   memory_usage_of(levels);
+    result.variables = memory_usage_of(variables) + memory_usage_of(m_lit_values);
+    result.buffers = memory_usage_of(m_unary_clauses) + memory_usage_of(learn_buffer) +
+                     memory_usage_of(supporting_decision_buffer);
+    return result;
+}
+
+template<typename Allocator>
+std::vector<bool> BasicPropagator<Allocator>::extract_assignment() const {
     const Var nv = m_num_vars;
     if(get_trail().size() != nv) {
         throw std::logic_error("Trail incomplete in extract_assignment!");
@@ -2017,6 +4419,21 @@ std::vector<bool> Propagator::extract_assignment() const {
     return result;
 }
 
+/**
+ * @brief A propagator using the default allocator.
+ */
+using Propagator = BasicPropagator<>;
+
+namespace pmr {
+
+/**
+ * @brief A propagator that obtains its memory from a std::pmr::memory_resource.
+ */
+using Propagator = BasicPropagator<std::pmr::polymorphic_allocator<Lit>>;
+
+}
+
+}
 }
 
 #endif
@@ -2028,6 +4445,7 @@ std::vector<bool> Propagator::extract_assignment() const {
 
 
 namespace sprop {
+inline namespace SPROP_INDEX_NAMESPACE {
 
 static inline constexpr Lit FIXED_TRUE = NIL - 1;
 static inline constexpr Lit FIXED_FALSE = NIL - 2;
@@ -2042,12 +4460,29 @@ static inline constexpr Lit FIXED_FALSE = NIL - 2;
  */
 class ReducedPartialExtractor {
   public:
+    /**
+     * @brief Breakdown of the memory used by a ReducedPartialExtractor.
+     */
+    struct MemoryBreakdown {
+        // The fixed-literal flags and the literal translation maps.
+        MemoryUsage literal_maps;
+        // The reduced clauses.
+        MemoryUsage reduced_clauses;
+        // Auxiliary buffers.
+        MemoryUsage buffers;
+
+        MemoryUsage total() const noexcept {
+            return literal_maps + reduced_clauses + buffers;
+        }
+    };
+
     ReducedPartialExtractor() = default;
 
     /**
      * @brief Extracts the reduced formula from the given propagator.
      */
-    inline void extract(const Propagator& propagator);
+    template<typename Allocator>
+    inline void extract(const BasicPropagator<Allocator>& propagator);
 
     /**
      * @brief Returns the reduced clauses.
@@ -2087,6 +4522,18 @@ class ReducedPartialExtractor {
         return m_old_to_new[old];
     }
 
+    /**
+     * @brief Get the memory currently used by the extractor.
+     */
+    MemoryBreakdown memory_usage() const noexcept {
+        return MemoryBreakdown{
+            memory_usage_of(m_old_lit_is_true) + memory_usage_of(m_old_lit_is_false) +
+                memory_usage_of(m_new_to_old) + memory_usage_of(m_old_to_new),
+            memory_usage_of(m_reduced_clauses),
+            memory_usage_of(m_new_clause_buffer)
+        };
+    }
+
   private:
     // Is the given old literal true?
     std::vector<bool> m_old_lit_is_true;
@@ -2108,7 +4555,8 @@ class ReducedPartialExtractor {
     // Buffer for new clauses.
     std::vector<Lit> m_new_clause_buffer;
 
-    void p_init_extraction(const Propagator& propagator) {
+    template<typename Allocator>
+    void p_init_extraction(const BasicPropagator<Allocator>& propagator) {
         std::size_t nv = propagator.num_vars();
         std::size_t nl = 2 * nv;
         m_old_lit_is_false.assign(nl, false);
@@ -2144,7 +4592,8 @@ class ReducedPartialExtractor {
         }
     }
 
-    void p_translate_binaries(const Propagator& propagator) {
+    template<typename Allocator>
+    void p_translate_binaries(const BasicPropagator<Allocator>& propagator) {
         // translate binaries:
         for(Lit l1 : propagator.all_literals()) {
             if(m_old_lit_is_false[l1]) {
@@ -2178,7 +4627,8 @@ class ReducedPartialExtractor {
         m_reduced_clauses.push_back(m_new_clause_buffer);
     }
 
-    void p_translate_clauses(const Propagator& propagator) {
+    template<typename Allocator>
+    void p_translate_clauses(const BasicPropagator<Allocator>& propagator) {
         // no need to translate unaries!
         p_translate_binaries(propagator);
         // translate longer clauses:
@@ -2190,13 +4640,15 @@ class ReducedPartialExtractor {
     }
 };
 
-void ReducedPartialExtractor::extract(const Propagator& propagator) {
+template<typename Allocator>
+void ReducedPartialExtractor::extract(const BasicPropagator<Allocator>& propagator) {
     p_init_extraction(propagator);
     p_make_literal_maps();
     p_translate_clauses(propagator);
     eliminate_subsumed(m_reduced_clauses, reduced_num_vars());
 }
 
+}
 }
 
 #endif
@@ -14,6 +14,9 @@
 #include <cstddef>
 #include <random>
 #include <set>
+#include <memory_resource>
+#include <climits>
+#include <type_traits>
 
 
 TEST_CASE("[empty] Ensure C++20 works as far as we need it") {
@@ -122,6 +125,654 @@ TEST_CASE("[Propagator] Basic CDCL SAT solver test case: waerden(3, 3; 9)") {
 }
 
 
+TEST_CASE("[types] Index traits") {
+    using namespace sprop;
+    static_assert(IndexTraitsType<DefaultIndexTraits>);
+    static_assert(IndexTraitsType<WideClauseRefIndexTraits>);
+    static_assert(sizeof(ClauseRef) == sizeof(IndexTraits::clause_ref_type));
+    static_assert(sizeof(ClauseRef) * CHAR_BIT == SPROP_CLAUSE_REF_BITS);
+    // all components live in the inline namespace of the configured widths
+    static_assert(std::is_same_v<Propagator, sprop::SPROP_INDEX_NAMESPACE::Propagator>);
+    static_assert(std::is_same_v<ModelBuilder, sprop::SPROP_INDEX_NAMESPACE::ModelBuilder>);
+    // reasons can hold the largest clause references
+    Reason reason = Reason::Clause{5, NIL_CLAUSE - 1};
+    CHECK(reason.reason_length == 5);
+    CHECK(reason.clause == NIL_CLAUSE - 1);
+    Reason binary = Reason::Binary{NIL - 1, NIL - 2};
+    CHECK(binary.literals[0] == NIL - 1);
+    CHECK(binary.literals[1] == NIL - 2);
+}
+
+
+sprop::ModelBuilder random_3sat(int num_vars, int num_clauses, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<sprop::Lit> lit_dist(0, 2 * num_vars - 1);
+    sprop::ModelBuilder builder;
+    builder.reserve_variables(num_vars);
+    for(int i = 0; i < num_clauses; ++i) {
+        sprop::Lit l1 = lit_dist(rng), l2 = lit_dist(rng), l3 = lit_dist(rng);
+        while(sprop::lit::var(l2) == sprop::lit::var(l1)) l2 = lit_dist(rng);
+        while(sprop::lit::var(l3) == sprop::lit::var(l1) || sprop::lit::var(l3) == sprop::lit::var(l2)) l3 = lit_dist(rng);
+        builder.add_clause(l1, l2, l3);
+    }
+    return builder;
+}
+
+
+/**
+ * A very simple CDCL loop; returns true iff the formula is satisfiable,
+ * in which case the propagator contains a full assignment.
+ */
+template<typename PropagatorType>
+bool solve_cdcl(PropagatorType& propagator) {
+    using namespace sprop;
+    if(propagator.is_conflicting()) return false;
+    for(;;) {
+        auto next_open = std::ranges::find_if(propagator.all_literals(), [&] (Lit l) { 
+            return propagator.is_open(l); 
+        });
+        if(next_open == propagator.all_literals().end()) return true;
+        if(!propagator.push_level(lit::negate(*next_open))) {
+            if(!propagator.resolve_conflicts()) return false;
+        }
+    }
+}
+
+
+TEST_CASE("[Propagator] Learnt clause reduction") {
+    using namespace sprop;
+    std::size_t num_deleted = 0;
+    for(std::uint64_t seed = 0; seed < 20; ++seed) {
+        auto model = random_3sat(60, 255, seed);
+        Propagator reference(model);
+        bool reference_result = solve_cdcl(reference);
+        Propagator propagator(model);
+        propagator.set_learnt_reduction_interval(8);
+        bool result = [&] {
+            for(;;) {
+                auto next_open = std::ranges::find_if(propagator.all_literals(), [&] (Lit l) { 
+                    return propagator.is_open(l); 
+                });
+                if(next_open == propagator.all_literals().end()) return true;
+                if(!propagator.push_level(lit::negate(*next_open))) {
+                    if(!propagator.resolve_conflicts()) return false;
+                    std::size_t before = propagator.num_learnt_clauses();
+                    if(before > 20) {
+                        propagator.reduce_learnts();
+                        propagator.compact_watches();
+                        CHECK(propagator.num_learnt_clauses() <= before);
+                        num_deleted += before - propagator.num_learnt_clauses();
+                    }
+                }
+            }
+        }();
+        CHECK(result == reference_result);
+        if(result) {
+            CHECK(!model.verify_trail(propagator.get_trail()));
+        }
+        // all clauses in the database remain well-formed
+        std::size_t num_learnt = 0;
+        for(ClauseRef c = propagator.first_longer_clause(); c < propagator.longer_clause_end(); 
+            c = propagator.next_clause(c)) 
+        {
+            CHECK(propagator.clause_length(c) >= 3);
+            ClauseHeader header = propagator.header_of(c);
+            if(header.is_learnt()) {
+                ++num_learnt;
+                CHECK(!header.is_garbage());
+                CHECK(header.lbd() >= 1);
+            }
+        }
+        CHECK(num_learnt == propagator.num_learnt_clauses());
+    }
+    CHECK(num_deleted > 0);
+}
+
+
+TEST_CASE("[Propagator] Binary clause storage with learnt binaries") {
+    using namespace sprop;
+    auto partner_lists = [] (const Propagator& propagator) {
+        std::vector<std::vector<Lit>> result;
+        for(Lit l : propagator.all_literals()) {
+            std::vector<Lit> partners;
+            std::ranges::copy(propagator.binary_partners_of(l), std::back_inserter(partners));
+            std::ranges::sort(partners);
+            result.push_back(std::move(partners));
+        }
+        return result;
+    };
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        auto model = random_3sat(50, 180, seed);
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<Lit> lit_dist(0, 99);
+        for(int i = 0; i < 20; ++i) {
+            Lit l1 = lit_dist(rng), l2 = lit_dist(rng);
+            if(lit::var(l1) != lit::var(l2)) model.add_clause(l1, l2);
+        }
+        Propagator propagator(model);
+        auto original = partner_lists(propagator);
+        for(Lit l : propagator.all_literals()) {
+            // the original partners are sorted and free of duplicates
+            std::span<const Lit> partners = propagator.original_binary_partners_of(l);
+            CHECK(std::ranges::equal(partners, original[l]));
+        }
+        bool result = solve_cdcl(propagator);
+        if(result) {
+            CHECK(!model.verify_trail(propagator.get_trail()));
+        }
+        auto before_merge = partner_lists(propagator);
+        for(std::size_t l = 0; l < original.size(); ++l) {
+            CHECK(std::ranges::includes(before_merge[l], original[l]));
+        }
+        propagator.merge_learnt_binaries();
+        CHECK(partner_lists(propagator) == before_merge);
+    }
+}
+
+
+TEST_CASE("[Propagator] Prefetch lookahead does not change propagation") {
+    using namespace sprop;
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        auto model = random_3sat(60, 240, seed);
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<Lit> var_dist(0, 59);
+        for(int i = 0; i < 30; ++i) {
+            // five literals on distinct variables
+            Lit v = var_dist(rng);
+            for(Lit j = 0; j < 5; ++j) {
+                model.add_literal(2 * ((v + 11 * j) % 60) + (rng() & 1));
+            }
+            model.finalize_clause();
+        }
+        Propagator plain(model);
+        Propagator prefetching(model);
+        CHECK(plain.get_prefetch_lookahead() == SPROP_DEFAULT_PREFETCH_LOOKAHEAD);
+        prefetching.set_prefetch_lookahead(5);
+        CHECK(solve_cdcl(plain) == solve_cdcl(prefetching));
+        CHECK(plain.get_trail() == prefetching.get_trail());
+        CHECK(plain.num_learnt_clauses() == prefetching.num_learnt_clauses());
+    }
+}
+
+
+TEST_CASE("[Propagator] Ternary clauses propagate through occurrence lists") {
+    using namespace sprop;
+    auto check_reason = [] (const Propagator& propagator, Lit implied, Reason reason) {
+        ClausePtrRange lits = reason.lits(propagator);
+        if(reason.reason_length == 3) {
+            CHECK(!reason.is_clause_ref());
+            CHECK(std::ranges::find(lits, implied) != lits.end());
+        }
+        for(Lit l : lits) {
+            if(l != implied) CHECK(propagator.is_false(l));
+        }
+    };
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        auto model = random_3sat(60, 255, seed);
+        Propagator propagator(model);
+        for(Lit v = 0; v < 60 && !propagator.is_conflicting(); ++v) {
+            Lit l = 2 * v + (seed & 1);
+            if(!propagator.is_open(l)) continue;
+            propagator.push_level(l);
+            for(Lit t : propagator.get_trail()) {
+                check_reason(propagator, t, propagator.get_reason(t));
+            }
+        }
+        if(propagator.is_conflicting()) {
+            auto [conflict_lit, conflict_reason] = propagator.get_conflict();
+            CHECK(!conflict_reason.is_clause_ref());
+            for(Lit l : conflict_reason.lits(propagator)) CHECK(propagator.is_false(l));
+        }
+        Propagator solving(model);
+        if(solve_cdcl(solving)) {
+            CHECK(!model.verify_trail(solving.get_trail()));
+        }
+    }
+}
+
+
+TEST_CASE("[Propagator] Saved search position in long clauses") {
+    using namespace sprop;
+    ClauseLen max_learnt_length = 0;
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        // at-least-one constraints over 20 of 60 variables each, on top of 3-SAT
+        auto model = random_3sat(60, 200, seed);
+        std::mt19937_64 rng(seed);
+        for(int i = 0; i < 40; ++i) {
+            Lit first = rng() % 60;
+            for(Lit j = 0; j < 20; ++j) {
+                model.add_literal(2 * ((first + 3 * j) % 60) + (rng() % 4 == 0));
+            }
+            model.finalize_clause();
+        }
+        Propagator propagator(model);
+        bool result = solve_cdcl(propagator);
+        if(result) {
+            CHECK(!model.verify_trail(propagator.get_trail()));
+        }
+        auto check_clauses = [&] () {
+            std::size_t num_learnt = 0;
+            for(ClauseRef c = propagator.first_longer_clause(); c < propagator.longer_clause_end(); 
+                c = propagator.next_clause(c)) 
+            {
+                if(propagator.is_learnt(c)) {
+                    ++num_learnt;
+                    max_learnt_length = (std::max)(max_learnt_length, propagator.clause_length(c));
+                }
+                CHECK(propagator.clause_length(c) >= 3);
+                CHECK(propagator.cref_of(propagator.lits_of(c)) == c);
+            }
+            CHECK(num_learnt == propagator.num_learnt_clauses());
+        };
+        check_clauses();
+        propagator.reset_to_zero();
+        propagator.reduce_learnts();
+        check_clauses();
+    }
+    CHECK(max_learnt_length >= SPROP_SAVED_SEARCH_MIN_LENGTH);
+}
+
+
+TEST_CASE("[Propagator] Binary-first propagation") {
+    using namespace sprop;
+    auto sorted_trail = [] (const Propagator& propagator) {
+        std::vector<Lit> trail(propagator.get_trail().begin(), propagator.get_trail().end());
+        std::ranges::sort(trail);
+        return trail;
+    };
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        auto model = random_3sat(100, 150, seed);
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<Lit> lit_dist(0, 199);
+        for(int i = 0; i < 120; ++i) {
+            Lit l1 = lit_dist(rng), l2 = lit_dist(rng);
+            if(lit::var(l1) != lit::var(l2)) model.add_clause(l1, l2);
+        }
+        Propagator plain(model);
+        Propagator binary_first(model);
+        CHECK(!binary_first.get_binary_first_propagation());
+        binary_first.set_binary_first_propagation(true);
+        CHECK(binary_first.get_binary_first_propagation());
+        if(plain.is_conflicting()) continue;
+        for(int dive = 0; dive < 20; ++dive) {
+            for(;;) {
+                Lit l = lit_dist(rng);
+                if(!plain.is_open(l)) {
+                    if(plain.get_trail().size() == plain.num_vars()) break;
+                    continue;
+                }
+                bool result = plain.push_level(l);
+                REQUIRE(binary_first.push_level(l) == result);
+                if(!result) {
+                    // both propagated a conflicting level; the conflicts may differ
+                    auto [conflict_lit, conflict_reason] = binary_first.get_conflict();
+                    for(Lit lr : conflict_reason.lits(binary_first)) CHECK(binary_first.is_false(lr));
+                    break;
+                }
+                CHECK(sorted_trail(plain) == sorted_trail(binary_first));
+            }
+            plain.reset_to_zero();
+            binary_first.reset_to_zero();
+        }
+        Propagator solving(model);
+        solving.set_binary_first_propagation(true);
+        if(solve_cdcl(solving)) {
+            CHECK(!model.verify_trail(solving.get_trail()));
+        }
+    }
+}
+
+
+TEST_CASE("[Propagator] Pushing assumptions in a batch") {
+    using namespace sprop;
+    auto lnot = lit::negate;
+    auto [vars, model] = waerden33(8);
+    Propagator propagator(model);
+    // vars[3] is false after vars[1] and vars[2], so it is skipped
+    std::vector<Lit> assumptions{vars[1], vars[2], lnot(vars[3]), vars[5]};
+    CHECK(propagator.push_assumptions(assumptions) == assumptions.size());
+    CHECK(propagator.get_current_level() == 3);
+    CHECK(propagator.get_decisions() == std::vector<Lit>{vars[1], vars[2], vars[5]});
+    // an assumption that is already false fails without a conflict
+    std::vector<Lit> failing{vars[6], vars[3], vars[7]};
+    CHECK(propagator.push_assumptions(failing) == 1);
+    CHECK(!propagator.is_conflicting());
+    CHECK(propagator.get_current_level() == 4);
+    CHECK(propagator.push_assumptions({}) == 0);
+    propagator.reset_to_zero();
+    // a conflict stops at the assumption that caused it
+    std::vector<Lit> conflicting{vars[1], vars[2], vars[4], vars[8]};
+    CHECK(propagator.push_assumptions(conflicting) == 2);
+    CHECK(propagator.is_conflicting());
+    CHECK(propagator.get_current_level() == 3);
+    CHECK_THROWS_AS(propagator.push_assumptions(conflicting), std::invalid_argument);
+    // same results as pushing the levels one by one
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        auto random_model = random_3sat(100, 400, seed);
+        Propagator batch(random_model);
+        Propagator single(random_model);
+        if(batch.is_conflicting()) continue;
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<Lit> lit_dist(0, 199);
+        std::vector<Lit> random_assumptions;
+        for(int i = 0; i < 60; ++i) random_assumptions.push_back(lit_dist(rng));
+        std::size_t failed = batch.push_assumptions(random_assumptions);
+        std::size_t expected = random_assumptions.size();
+        for(std::size_t i = 0; i < random_assumptions.size(); ++i) {
+            Lit l = random_assumptions[i];
+            if(single.is_true(l)) continue;
+            if(single.is_false(l) || !single.push_level(l)) {
+                expected = i;
+                break;
+            }
+        }
+        CHECK(failed == expected);
+        CHECK(batch.get_trail() == single.get_trail());
+        CHECK(batch.is_conflicting() == single.is_conflicting());
+    }
+}
+
+
+TEST_CASE("[Propagator] Chronological backtracking") {
+    using namespace sprop;
+    // tracks the assignments known to the handler of resolve_conflicts
+    struct KnownAssignments {
+        std::set<Lit> known;
+        void assignment_undone(Lit l) { CHECK(known.erase(l) == 1); }
+        void assignment_forced(Lit l) { CHECK(known.insert(l).second); }
+    };
+    bool found_unsorted = false;
+    for(std::uint64_t seed = 0; seed < 10; ++seed) {
+        auto model = random_3sat(100, 420, seed);
+        Propagator reference(model);
+        bool satisfiable = solve_cdcl(reference);
+        for(std::uint32_t max_jump : {0u, 2u}) {
+            Propagator propagator(model);
+            CHECK(propagator.get_chronological_backtracking() == Propagator::always_backjump);
+            propagator.set_chronological_backtracking(max_jump);
+            CHECK(propagator.get_chronological_backtracking() == max_jump);
+            propagator.set_learnt_reduction_interval(50);
+            bool result = !propagator.is_conflicting();
+            while(result) {
+                auto next_open = std::ranges::find_if(propagator.all_literals(), [&] (Lit l) {
+                    return propagator.is_open(l);
+                });
+                if(next_open == propagator.all_literals().end()) break;
+                if(propagator.push_level(lit::negate(*next_open))) continue;
+                KnownAssignments handler;
+                handler.known.insert(propagator.get_trail().begin(), propagator.current_level_begin());
+                if(!propagator.resolve_conflicts(handler)) {
+                    result = false;
+                    break;
+                }
+                const auto& trail = propagator.get_trail();
+                CHECK(handler.known == std::set<Lit>(trail.begin(), trail.end()));
+                bool consistent = true;
+                std::int32_t max_level = 0;
+                for(std::size_t i = 0; i < trail.size(); ++i) {
+                    std::int32_t level = propagator.get_decision_level(trail[i]);
+                    consistent &= (propagator.get_trail_index(trail[i]) == i);
+                    consistent &= (level <= propagator.get_current_level());
+                    found_unsorted |= (level < max_level);
+                    max_level = (std::max)(max_level, level);
+                }
+                REQUIRE(consistent);
+            }
+            CHECK(result == satisfiable);
+            if(result) {
+                CHECK(!model.verify_trail(propagator.get_trail()));
+            }
+            propagator.reset_to_zero();
+            CHECK(propagator.get_current_level() == 0);
+        }
+    }
+    CHECK(found_unsorted);
+}
+
+
+TEST_CASE("[SlabListStore] Random operations") {
+    using namespace sprop;
+    std::mt19937_64 rng(42);
+    SlabListStore<Lit> store;
+    std::vector<std::vector<Lit>> reference(50);
+    store.resize(50);
+    auto matches = [&] () {
+        for(std::size_t l = 0; l < reference.size(); ++l) {
+            if(!std::ranges::equal(store[l], reference[l])) return false;
+            if(store.capacity(l) < reference[l].size()) return false;
+        }
+        return true;
+    };
+    std::uniform_int_distribution<std::size_t> list_dist(0, 49);
+    std::uniform_int_distribution<int> op_dist(0, 99);
+    for(int round = 0; round < 20000; ++round) {
+        std::size_t l = list_dist(rng);
+        int op = op_dist(rng);
+        if(op < 90) {
+            Lit value = Lit(rng());
+            store.push_back(l, value);
+            reference[l].push_back(value);
+        } else if(op < 99) {
+            std::uint32_t new_size = std::uint32_t(reference[l].size() / 2);
+            store.truncate(l, new_size);
+            reference[l].resize(new_size);
+        } else {
+            store.compact();
+            CHECK(store.free_entries() == 0);
+        }
+    }
+    CHECK(matches());
+    auto before = store.memory_usage();
+    store.compact();
+    CHECK(matches());
+    auto after = store.memory_usage();
+    CHECK(after.reserved <= before.reserved);
+    SlabListStore<Lit> copy(store);
+    store.resize(10);
+    for(std::size_t l = 0; l < 10; ++l) {
+        store.push_back(l, 0);
+    }
+    CHECK(std::ranges::equal(copy[49], reference[49]));
+}
+
+
+#if SPROP_MAPPED_CLAUSE_ARENA
+TEST_CASE("[MappedArena] Growth beyond the initial reservation") {
+    using namespace sprop;
+    MappedArena<Lit> arena;
+    const std::size_t n = MappedArena<Lit>::initial_reservation / sizeof(Lit) + 1000;
+    for(std::size_t i = 0; i < n; ++i) {
+        arena.push_back(Lit(i));
+    }
+    REQUIRE(arena.size() == n);
+    CHECK(arena.capacity() >= n);
+    CHECK(arena[0] == 0);
+    CHECK(arena[n - 1] == Lit(n - 1));
+    std::vector<Lit> values{7, 8, 9};
+    arena.insert(arena.begin() + 1, values.begin(), values.end());
+    CHECK(arena[1] == 7);
+    CHECK(arena[3] == 9);
+    CHECK(arena[4] == 1);
+    arena.resize(10);
+    arena.resize(20);
+    CHECK(arena[9] == 6);
+    CHECK(arena[10] == 0);
+    MappedArena<Lit> copy(arena);
+    arena.clear();
+    CHECK(copy.size() == 20);
+    CHECK(copy[2] == 8);
+    CHECK(memory_usage_of(copy).used == 20 * sizeof(Lit));
+}
+#endif
+
+
+TEST_CASE("[LiteralSearch] Vectorized and scalar search agree") {
+    using namespace sprop;
+    std::mt19937_64 rng(1234);
+    const std::size_t num_lits = 203;
+    std::vector<std::int8_t> values(LiteralSearch::padded_size(num_lits), 0);
+    std::uniform_int_distribution<Lit> lit_dist(0, Lit(num_lits - 1));
+    for(int round = 0; round < 2000; ++round) {
+        for(std::size_t l = 0; l < num_lits; ++l) {
+            // mostly false values, so the matches are spread over the whole range
+            values[l] = (rng() % 16 == 0) ? std::int8_t(rng() % 2) : std::int8_t(-1);
+        }
+        std::vector<Lit> lits(rng() % 100);
+        std::ranges::generate(lits, [&] () { return lit_dist(rng); });
+        const Lit* begin = lits.data();
+        const Lit* end = begin + lits.size();
+        CHECK(LiteralSearch::find_non_false(begin, end, values.data()) ==
+              LiteralSearch::find_non_false_scalar(begin, end, values.data()));
+    }
+    INFO("kernel: " << LiteralSearch::kernel_name());
+
+    // propagation through a long clause
+    ModelBuilder builder;
+    std::vector<Lit> clause;
+    for(int i = 0; i < 41; ++i) {
+        clause.push_back(builder.add_variable());
+    }
+    builder.add_clause(clause);
+    Propagator propagator(builder);
+    std::ranges::shuffle(clause, rng);
+    for(std::size_t i = 0; i + 1 < clause.size(); ++i) {
+        REQUIRE(propagator.is_open(clause.back()));
+        REQUIRE(propagator.push_level(lit::negate(clause[i])));
+    }
+    CHECK(propagator.is_true(clause.back()));
+}
+
+
+TEST_CASE("[Propagator] Copies share the original clauses") {
+    using namespace sprop;
+    auto lnot = lit::negate;
+    auto [vars, model] = waerden33(8);
+    Propagator propagator(model);
+    Propagator copy(propagator);
+    ClauseRef first = propagator.first_longer_clause();
+    CHECK(propagator.lits_of(first).begin() == copy.lits_of(first).begin());
+    CHECK(propagator.cref_of(copy.lits_of(first)) == first);
+    REQUIRE(propagator.push_level(vars[1]));
+    REQUIRE(propagator.push_level(vars[2]));
+    REQUIRE(!propagator.push_level(vars[4]));
+    REQUIRE(propagator.resolve_conflicts());
+    REQUIRE(propagator.get_trail().size() == 8);
+    // the copy is unaffected by the decisions and learnt clauses of the original
+    CHECK(copy.get_trail().empty());
+    CHECK(copy.num_learnt_clauses() == 0);
+    REQUIRE(copy.push_level(lnot(vars[1])));
+    REQUIRE(copy.push_level(lnot(vars[2])));
+    REQUIRE(copy.get_trail() == std::vector<Lit>{lnot(vars[1]), lnot(vars[2]), vars[3]});
+    Propagator second_copy(propagator);
+    CHECK(second_copy.get_trail() == propagator.get_trail());
+    CHECK(!model.verify_trail(second_copy.get_trail()));
+}
+
+
+TEST_CASE("[Propagator] Propagators using a memory resource") {
+    using namespace sprop;
+    // forwards to the new/delete resource and counts the bytes in use
+    struct CountingResource : std::pmr::memory_resource {
+        std::size_t in_use = 0;
+        std::size_t total = 0;
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            in_use += bytes;
+            total += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            in_use -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    for(std::uint64_t seed = 0; seed < 5; ++seed) {
+        auto model = random_3sat(50, 215, seed);
+        Propagator reference(model);
+        bool expected = solve_cdcl(reference);
+        CountingResource counting;
+        {
+            pmr::Propagator propagator(model, &counting);
+            CHECK(propagator.get_allocator().resource() == &counting);
+            CHECK(counting.total > 0);
+            std::pmr::monotonic_buffer_resource arena(&counting);
+            // any allocation not going through the arena would throw
+            auto* old_default = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+            bool result = false;
+            {
+                pmr::Propagator copy(propagator, &arena);
+                result = solve_cdcl(copy);
+                if(result) {
+                    CHECK(!model.verify_trail(copy.get_trail()));
+                }
+            }
+            std::pmr::set_default_resource(old_default);
+            CHECK(result == expected);
+            // the source propagator is unaffected
+            CHECK(propagator.get_current_level() == 0);
+            CHECK(propagator.num_learnt_clauses() == 0);
+        }
+        CHECK(counting.in_use == 0);
+    }
+}
+
+
+TEST_CASE("[Propagator] Memory usage breakdown") {
+    using namespace sprop;
+    auto consistent = [] (const MemoryUsage& m) { return m.used <= m.reserved; };
+    auto model = random_3sat(60, 255, 3);
+    auto model_usage = model.memory_usage();
+    CHECK(model_usage.longer_clauses.used >= 255 * 3 * sizeof(Lit));
+    CHECK(consistent(model_usage.unary_clauses));
+    CHECK(consistent(model_usage.binary_clauses));
+    CHECK(consistent(model_usage.longer_clauses));
+    CHECK(consistent(model_usage.total()));
+    Propagator propagator(model);
+    auto initial = propagator.memory_usage();
+    CHECK(initial.original_clauses.used >= 255 * 5 * sizeof(Lit));
+    CHECK(initial.learnt_clauses.used == 0);
+    CHECK(initial.watch_lists.used > 0);
+    CHECK(initial.variables.used > 0);
+    solve_cdcl(propagator);
+    auto solved = propagator.memory_usage();
+    std::size_t learnt_bytes = 0;
+    for(ClauseRef c = propagator.first_longer_clause(); c < propagator.longer_clause_end(); 
+        c = propagator.next_clause(c)) 
+    {
+        if(propagator.is_learnt(c)) {
+            // header, length, literals and (for long clauses) the saved search position
+            learnt_bytes += (propagator.next_clause(c) - c) * sizeof(Lit);
+        }
+    }
+    CHECK(solved.learnt_clauses.used == learnt_bytes);
+    CHECK(solved.original_clauses.used == initial.original_clauses.used);
+    for(const MemoryUsage& m : {solved.original_clauses, solved.learnt_clauses, solved.watch_lists,
+                                solved.binary_clauses, solved.trail, solved.variables, solved.buffers})
+    {
+        CHECK(consistent(m));
+    }
+    CHECK(solved.total().used == solved.original_clauses.used + solved.total_unshared().used);
+    Propagator copy(propagator);
+    CHECK(copy.memory_usage().original_clauses.used == solved.original_clauses.used);
+    CHECK(copy.memory_usage().learnt_clauses.used == solved.learnt_clauses.used);
+    ReducedPartialExtractor extractor;
+    CHECK(extractor.memory_usage().total().reserved == 0);
+    Propagator fresh(model);
+    REQUIRE(fresh.push_level(0));
+    extractor.extract(fresh);
+    auto extractor_usage = extractor.memory_usage();
+    CHECK(extractor_usage.literal_maps.used > 0);
+    CHECK(extractor_usage.reduced_clauses.used > 0);
+    CHECK(consistent(extractor_usage.total()));
+}
+
+
 TEST_CASE("[eliminate_subsumed] Test eliminate subsumed - no subsumed") {
     using namespace sprop;
     auto [vars, model] = waerden33(9);